@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    Bench.h
+    Created: 17 Oct 2026 9:14:03pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+namespace nvs::bench {
+
+/**
+ Tallies the pass/fail checks of a run: the benchmarks only report, the checks decide the exit code (and so what ctest sees).
+ */
+struct Checks {
+	int failures {0};
+	
+	void expect(bool const ok, char const *const what){
+		std::printf("    %s  %s\n", ok ? "ok  " : "FAIL", what);
+		failures += ok ? 0 : 1;
+	}
+};
+
+/**
+ Nanoseconds per item of run(), which processes itemsPerRun items: the best of repeats timed runs, after one untimed one
+ to warm the caches.
+ */
+template <typename Run>
+double nanosecondsPerItem(std::size_t const itemsPerRun, int const repeats, Run &&run){
+	using clock = std::chrono::steady_clock;
+	run();
+	double best {std::numeric_limits<double>::max()};
+	for (int r = 0; r < repeats; ++r){
+		auto const start = clock::now();
+		run();
+		std::chrono::duration<double, std::nano> const elapsed = clock::now() - start;
+		best = std::min(best, elapsed.count());
+	}
+	return best / static_cast<double>(itemsPerRun);
+}
+
+// keeps a benchmarked result from being optimised away
+inline volatile float sink;
+inline void consume(float const x){
+	sink = x;
+}
+
+void runInterpolationBench(Checks &checks);
+void runSourceBufferTests(Checks &checks);
+void runRandomTests(Checks &checks);
+void runGrainWindowTests(Checks &checks);
+void runGrainPoolBench(Checks &checks);
+void runVoiceRenderingBench(Checks &checks);
+}	// namespace nvs::bench
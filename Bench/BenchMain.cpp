@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    BenchMain.cpp
+    Created: 17 Oct 2026 9:14:03pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+
+/**
+ Micro-benchmarks of the synthesis kernels, with the correctness checks that go with them.
+ Build with -DSLICER_GRANULAR_BUILD_BENCH=ON (in Release, for the timings to mean anything); ctest runs it for the checks.
+ */
+int main(){
+	nvs::bench::Checks checks;
+	nvs::bench::runInterpolationBench(checks);
+	nvs::bench::runSourceBufferTests(checks);
+	nvs::bench::runRandomTests(checks);
+	nvs::bench::runGrainWindowTests(checks);
+	nvs::bench::runGrainPoolBench(checks);
+	nvs::bench::runVoiceRenderingBench(checks);
+	
+	std::printf("\n%d failed check(s)\n", checks.failures);
+	return checks.failures == 0 ? 0 : 1;
+}
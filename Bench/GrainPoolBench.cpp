@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    GrainPoolBench.cpp
+    Created: 17 Oct 2026 11:21:35pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+#include "Synthesis/GrainPool.h"
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace nvs::bench {
+
+namespace {
+using namespace nvs::gran;
+
+constexpr std::size_t sourceLength {48000 * 10};
+constexpr int renderLength {2048};	// samples per timed run, rendered span by span
+constexpr int repeats {3};
+constexpr std::array<std::size_t, 6> grainCounts {8, 16, 32, 64, 128, 256};
+constexpr std::array<int, 5> spans {16, 32, 64, 128, 512};
+
+SourceBuffer makeSource(){
+	SourceBuffer source (2, sourceLength);
+	float *const frames = source.getFrames();
+	std::mt19937 engine (5);
+	std::uniform_real_distribution<float> noise (-1.f, 1.f);
+	for (std::size_t i = 0; i < 2 * sourceLength; ++i){
+		frames[i] = noise(engine);
+	}
+	source.fillGuards();
+	return source;
+}
+/**
+ Starts numGrains grains on owner 0, all of them sounding for far longer than the benchmark runs, at scattered positions
+ and rates. The same seed starts the same grains.
+ */
+void startGrains(GrainPool &pool, SourceLevels const &source, std::size_t const numGrains){
+	std::mt19937 engine (9);
+	std::uniform_real_distribution<double> position (0.0, static_cast<double>(sourceLength));
+	std::uniform_real_distribution<double> octaves (-1.0, 1.0);
+	std::uniform_real_distribution<float> pan (0.f, 1.f);
+	for (std::size_t g = 0; g < numGrains; ++g){
+		auto const slot = pool.acquire(0, static_cast<int>(g), engine);
+		if (!slot){
+			return;
+		}
+		GrainSpawn spawn;
+		spawn.window_length = 1.0e9;
+		spawn.index_origin = position(engine);
+		spawn.index_rate = std::exp2(octaves(engine));
+		spawn.amplitude = 0.1f;
+		spawn.gain_L = pan(engine);
+		spawn.gain_R = 1.f - spawn.gain_L;
+		pool.start(*slot, spawn, source);
+	}
+}
+double nanosecondsPerSample(GrainPool &pool, int const span, std::vector<float> &L, std::vector<float> &R){
+	return nanosecondsPerItem(renderLength, repeats, [&]{
+		for (int start = 0; start < renderLength; start += span){
+			pool.render(0, L.data() + start, R.data() + start, std::min(span, renderLength - start));
+		}
+		consume(L[renderLength / 2]);
+	});
+}
+}	// namespace
+
+/**
+ Where spreading one voice's grains over the render workers starts to pay: render() on the calling thread against render()
+ forking to the workers, for each engine, by number of sounding grains and by span (the samples between two onsets, which
+ is what PolyGrain hands render() at a time). GrainPool::defaultMinParallelGrains and defaultMinParallelSpan should sit at
+ the crossover on the machines the plugin ships to; they are placeholders until this has been run on multi-core hardware.
+ The parallel path is also checked against the serial one.
+ */
+void runGrainPoolBench(Checks &checks){
+	int const numThreads = std::max(juce::SystemStats::getNumCpus(), 2);
+	std::printf("\nGrain rendering, serial / parallel time on %d threads (> 1: parallel is faster); defaults: %zu grains, %d samples\n",
+				numThreads, GrainPool::defaultMinParallelGrains, GrainPool::defaultMinParallelSpan);
+	
+	auto const frames = makeSource();
+	SourceLevels const source {frames.view(), nullptr};
+	GrainWindowTable const windowTable;
+	RenderWorkerPool workers;
+	workers.start(numThreads - 1);
+	std::vector<float> L (renderLength), R (renderLength);
+	
+	for (auto const engine : {GrainEngine::scalar, GrainEngine::structureOfArrays}){
+		std::printf("  %s engine\n    grains", (engine == GrainEngine::scalar) ? "scalar" : "structureOfArrays");
+		for (int const span : spans){
+			std::printf("  span %4d", span);
+		}
+		std::printf("\n");
+		for (std::size_t const numGrains : grainCounts){
+			GrainPool pool (numGrains, windowTable);
+			pool.setEngine(engine);
+			startGrains(pool, source, numGrains);
+			std::printf("    %6zu", numGrains);
+			for (int const span : spans){
+				pool.setGrainWorkers(nullptr);
+				double const serial = nanosecondsPerSample(pool, span, L, R);
+				pool.setGrainWorkers(&workers, 1, 1);
+				double const parallel = nanosecondsPerSample(pool, span, L, R);
+				std::printf("  %9.2f", serial / parallel);
+			}
+			std::printf("\n");
+		}
+		
+		// the same grains rendered both ways sum in a different order, so they agree to rounding only
+		constexpr std::size_t numGrains {64};
+		GrainPool serialPool (numGrains, windowTable), parallelPool (numGrains, windowTable);
+		serialPool.setEngine(engine);
+		parallelPool.setEngine(engine);
+		parallelPool.setGrainWorkers(&workers, 1, 1);
+		startGrains(serialPool, source, numGrains);
+		startGrains(parallelPool, source, numGrains);
+		std::vector<float> serialL (renderLength), serialR (renderLength), parallelL (renderLength), parallelR (renderLength);
+		serialPool.render(0, serialL.data(), serialR.data(), renderLength);
+		parallelPool.render(0, parallelL.data(), parallelR.data(), renderLength);
+		float worst {0.f};
+		for (int i = 0; i < renderLength; ++i){
+			worst = std::max({worst, std::abs(serialL[i] - parallelL[i]), std::abs(serialR[i] - parallelR[i])});
+		}
+		checks.expect(worst < 1e-5f, (engine == GrainEngine::scalar) ? "parallel scalar render matches serial"
+																	  : "parallel structureOfArrays render matches serial");
+	}
+	workers.stop();
+}
+}	// namespace nvs::bench
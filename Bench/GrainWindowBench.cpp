@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    GrainWindowBench.cpp
+    Created: 18 Oct 2026 2:14:09pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+#include "Synthesis/GrainWindow.h"
+#include <cmath>
+#include <random>
+
+namespace nvs::bench {
+
+namespace {
+using namespace nvs::gran;
+
+constexpr int numSamples {1 << 22};
+}	// namespace
+
+/**
+ GrainWindowTable against the analytic window it stands in for: the worst deviation the constructor measures at the cell
+ centres, and the worst of numSamples (plateau, triangle) pairs drawn log-uniformly over the tabulated plateaus, so off the
+ centres and between rows, must both stay under GrainWindowTable::maxError.
+ */
+void runGrainWindowTests(Checks &checks){
+	GrainWindowTable const table;
+	std::mt19937 engine (31);
+	std::uniform_real_distribution<float> decades (0.f, std::log10(GrainWindowTable::maxPlateau / GrainWindowTable::minPlateau));
+	std::uniform_real_distribution<float> triangle (0.f, 1.f);
+	float worst {0.f};
+	float worstPlateau {0.f};
+	for (int n = 0; n < numSamples; ++n){
+		float const plateau = GrainWindowTable::minPlateau * std::pow(10.f, decades(engine));
+		float const t = triangle(engine);
+		float const error = std::abs(table(table.makeKey(plateau), t) - shapeWindow(t, plateau));
+		if (error > worst){
+			worst = error;
+			worstPlateau = plateau;
+		}
+	}
+	std::printf("\nGrain window table: measured at cell centres %.2e, sampled %.2e (plateau %.3f); bound %.2e\n",
+				table.getMaxError(), worst, worstPlateau, GrainWindowTable::maxError);
+	checks.expect(table.getMaxError() < GrainWindowTable::maxError, "the window table's cell-centre error is under maxError");
+	checks.expect(worst < GrainWindowTable::maxError, "the window table's error anywhere on the grid is under maxError");
+}
+}	// namespace nvs::bench
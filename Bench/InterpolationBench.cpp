@@ -0,0 +1,355 @@
+/*
+  ==============================================================================
+
+    InterpolationBench.cpp
+    Created: 17 Oct 2026 9:14:03pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+#include "Synthesis/GrainPool.h"
+#include "Synthesis/Interpolation.h"
+#include "Synthesis/SourceBuffer.h"
+#include "Synthesis/SourcePyramid.h"
+#include "nvs_gen.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace nvs::bench {
+
+namespace {
+using gran::interp::hermiteGather;
+using gran::interp::hermiteGatherPortable;
+
+constexpr std::size_t sourceLength {48000 * 4};
+constexpr int numGrains {64};
+constexpr std::size_t readsPerGrain {1024};
+constexpr std::size_t numReads {numGrains * readsPerGrain};
+constexpr int repeats {50};
+
+gran::SourceBuffer makeSource(){
+	gran::SourceBuffer source (1, sourceLength);
+	float *const wave = source.getFrames();
+	for (std::size_t i = 0; i < sourceLength; ++i){
+		auto const t = static_cast<double>(i);
+		wave[i] = static_cast<float>(0.5 * std::sin(0.013 * t) + 0.3 * std::sin(0.171 * t) + 0.2 * std::sin(1.93 * t));
+	}
+	source.fillGuards();
+	return source;
+}
+/**
+ The read positions of numGrains grains of readsPerGrain consecutive reads each, from scattered starts at scattered rates,
+ one grain after another: the access pattern of a block of a dense cloud.
+ */
+std::vector<double> makeIndices(){
+	std::mt19937 engine (17);
+	std::uniform_real_distribution<double> start (0.0, static_cast<double>(sourceLength));
+	std::uniform_real_distribution<double> octaves (-1.0, 1.0);
+	std::vector<double> indices;
+	indices.reserve(numReads);
+	for (int g = 0; g < numGrains; ++g){
+		double const origin = start(engine);
+		double const rate = std::exp2(octaves(engine));
+		for (std::size_t i = 0; i < readsPerGrain; ++i){
+			indices.push_back(std::fmod(origin + rate * static_cast<double>(i), static_cast<double>(sourceLength)));
+		}
+	}
+	return indices;
+}
+float maxDifference(std::vector<float> const &a, std::vector<float> const &b){
+	float worst {0.f};
+	for (std::size_t i = 0; i < a.size(); ++i){
+		worst = std::max(worst, std::abs(a[i] - b[i]));
+	}
+	return worst;
+}
+
+constexpr std::size_t sineLength {4800};
+/**
+ A sine of cyclesPerSample on every channel, a whole number of cycles long, so that it carries on seamlessly across the wrap
+ point; numChannels > 1 puts it a quarter cycle later on each channel.
+ */
+gran::SourceBuffer makeSine(int const numChannels, double const cyclesPerSample){
+	gran::SourceBuffer source (numChannels, sineLength);
+	float *const frames = source.getFrames();
+	for (std::size_t i = 0; i < sineLength; ++i){
+		for (int c = 0; c < numChannels; ++c){
+			double const phase = cyclesPerSample * static_cast<double>(i) + 0.25 * c;
+			frames[i * static_cast<std::size_t>(numChannels) + static_cast<std::size_t>(c)] = static_cast<float>(std::sin(2.0 * std::numbers::pi * phase));
+		}
+	}
+	source.fillGuards();
+	return source;
+}
+std::vector<double> uniformIndices(double const from, double const to, std::size_t const count, unsigned const seed){
+	std::mt19937 engine (seed);
+	std::uniform_real_distribution<double> index (from, to);
+	std::vector<double> indices (count);
+	for (auto &x : indices){
+		x = index(engine);
+	}
+	return indices;
+}
+
+/**
+ The sinc kernel against Hermite on a sine at a quarter of the sample rate, well inside the sinc's passband but where a
+ 4-point kernel has lost most of its accuracy: the exact value at each fractional position is known, so both are measured
+ against it.
+ */
+void checkSincAccuracy(Checks &checks){
+	constexpr double cyclesPerSample {0.25};
+	auto const source = makeSine(1, cyclesPerSample);
+	float const *const wave = source.view().frames;
+	auto const indices = uniformIndices(0.0, static_cast<double>(sineLength), 1 << 16, 23);
+	std::vector<float> sinc (indices.size()), hermite (indices.size()), exact (indices.size());
+	gran::interp::gather<gran::interp::Quality::sinc>(wave, sineLength, indices.data(), sinc.data(), indices.size());
+	gran::interp::gather<gran::interp::Quality::hermite>(wave, sineLength, indices.data(), hermite.data(), indices.size());
+	for (std::size_t i = 0; i < indices.size(); ++i){
+		exact[i] = static_cast<float>(std::sin(2.0 * std::numbers::pi * cyclesPerSample * indices[i]));
+	}
+	float const sincError = maxDifference(sinc, exact);
+	float const hermiteError = maxDifference(hermite, exact);
+	std::printf("  sine at %.2f of the sample rate: worst error sinc %.2e, hermite %.2e\n", cyclesPerSample, sincError, hermiteError);
+	checks.expect(sincError < 0.01f * hermiteError, "sinc reproduces a band-limited sine to a hundredth of Hermite's error");
+}
+/**
+ Linear reads against a plain lerp of the two frames either side, wrapped by hand: at positions in [0, length), the last of
+ which reads its second tap from the guard, and at positions beyond either end, which are wrapped first. Mono and stereo,
+ whole-index and split.
+ */
+void checkLinearReads(Checks &checks){
+	using gran::interp::Quality;
+	auto const mono = makeSine(1, 0.0123);
+	auto const stereo = makeSine(2, 0.0123);
+	float const *const wave = mono.view().frames;
+	float const *const frames = stereo.view().frames;
+	auto const n = static_cast<long long>(sineLength);
+	auto const lerp = [n](float const *const from, int const channels, int const c, double const index){
+		double const whole = std::floor(index);
+		auto i0 = static_cast<long long>(whole) % n;
+		i0 += (i0 < 0) ? n : 0;
+		auto const i1 = (i0 + 1) % n;
+		float const y0 = from[i0 * channels + c];
+		float const y1 = from[i1 * channels + c];
+		return y0 + static_cast<float>(index - whole) * (y1 - y0);
+	};
+	auto const check = [&](std::vector<double> const &indices, char const *const what){
+		std::size_t const count = indices.size();
+		std::vector<float> expected (count), expectedR (count), gathered (count), read (count), outL (count), outR (count);
+		for (std::size_t i = 0; i < count; ++i){
+			expected[i] = lerp(wave, 1, 0, indices[i]);
+			expectedR[i] = lerp(frames, 2, 1, indices[i]);
+			read[i] = gran::interp::linearRead(wave, sineLength, indices[i]);
+		}
+		gran::interp::gather<Quality::linear>(wave, sineLength, indices.data(), gathered.data(), count);
+		gran::interp::gatherStereo<Quality::linear>(frames, sineLength, indices.data(), outL.data(), outR.data(), count);
+		float const worst = std::max({maxDifference(gathered, expected), maxDifference(read, expected), maxDifference(outR, expectedR)});
+		char message[96];
+		std::snprintf(message, sizeof message, "linear reads match a plain lerp %s", what);
+		checks.expect(worst < 1e-6f, message);
+	};
+	auto inRange = uniformIndices(0.0, static_cast<double>(sineLength), 1 << 14, 29);
+	inRange.push_back(static_cast<double>(sineLength) - 0.5);	// its second tap is the guard copy of frame 0
+	check(inRange, "in [0, length)");
+	std::vector<double> wrapped;
+	for (double const x : uniformIndices(-3.0 * sineLength, 4.0 * sineLength, 1 << 14, 31)){
+		if ((x < 0.0) || (x >= static_cast<double>(sineLength))){
+			wrapped.push_back(x);
+		}
+	}
+	check(wrapped, "beyond either end");
+	
+	// the split form takes positions already in [0, length)
+	std::vector<std::int32_t> wholes (inRange.size());
+	std::vector<float> fracs (inRange.size()), split (inRange.size()), expected (inRange.size());
+	for (std::size_t i = 0; i < inRange.size(); ++i){
+		double const whole = std::floor(inRange[i]);
+		wholes[i] = static_cast<std::int32_t>(whole);
+		fracs[i] = static_cast<float>(inRange[i] - whole);
+		expected[i] = wave[wholes[i]] + fracs[i] * (wave[(wholes[i] + 1) % n] - wave[wholes[i]]);
+	}
+	gran::interp::gather<Quality::linear>(wave, sineLength, wholes.data(), fracs.data(), split.data(), inRange.size());
+	checks.expect(maxDifference(split, expected) < 1e-6f, "split linear reads match a plain lerp");
+}
+/**
+ A grain transposed two octaves up must read the second octave of the pyramid, not level 0: on a source that is all
+ content above the octaves' cut-off, the grain is then near silent, where reading level 0 it aliases at full level.
+ Rendered through the pool, with each engine, with and without the octaves.
+ */
+void checkTransposedGrainReadsOctave(Checks &checks){
+	constexpr int renderLength {4096};
+	auto const source = makeSine(2, 0.4);
+	auto const pyramid = gran::SourcePyramid::build(source.view(), []{ return false; });
+	gran::GrainWindowTable const windowTable;
+	auto const energy = [&](gran::GrainEngine const engine, gran::SourcePyramid const *const octaves){
+		gran::SourceLevels const levels {source.view(), octaves};
+		gran::GrainPool pool (8, windowTable);
+		pool.setEngine(engine);
+		std::mt19937 rng (37);
+		auto const slot = pool.acquire(0, 0, rng);
+		gran::GrainSpawn spawn;
+		spawn.window_length = renderLength;
+		spawn.index_rate = 4.0;
+		spawn.amplitude = 1.f;
+		pool.start(*slot, spawn, levels);
+		std::vector<float> L (renderLength), R (renderLength);
+		pool.render(0, L.data(), R.data(), renderLength);
+		double sum {0.0};
+		for (int i = 0; i < renderLength; ++i){
+			sum += static_cast<double>(L[static_cast<std::size_t>(i)]) * L[static_cast<std::size_t>(i)];
+		}
+		return sum;
+	};
+	gran::SourceLevels const levels {source.view(), pyramid.get()};
+	checks.expect(levels.levelFor(4.0) == 2, "a stride of 4 maps to the second octave");
+	for (auto const engine : {gran::GrainEngine::scalar, gran::GrainEngine::structureOfArrays}){
+		double const octave = energy(engine, pyramid.get());
+		double const level0 = energy(engine, nullptr);
+		std::printf("  grain two octaves up (%s): energy %.3e from the octave, %.3e from level 0\n",
+					(engine == gran::GrainEngine::scalar) ? "scalar" : "structureOfArrays", octave, level0);
+		checks.expect((level0 > 1.0) && (octave < 1e-4 * level0),
+					  (engine == gran::GrainEngine::scalar) ? "a transposed scalar grain reads the decimated octave"
+														 : "a transposed structureOfArrays grain reads the decimated octave");
+	}
+}
+/**
+ On a source of odd length, whose octaves are a fraction of a frame longer than half the one above, a grain two octaves up
+ must still read where a grain on level 0 alone does after hundreds of passes, and stay there when retarget() moves it onto a
+ source without octaves and back. Both grains are started together in one pool, panned hard apart, so that their reads are
+ compared sample by sample (of five cycles of a sine, which the octaves pass all but unchanged), and their described
+ positions after each stretch.
+ */
+void checkTransposedGrainStaysLocked(Checks &checks){
+	constexpr std::size_t oddLength {1001};
+	constexpr int blockSize {64};
+	constexpr int blocksPerStretch {2000};	// a stretch reads 4 * 128000 samples: 511 passes
+	gran::SourceBuffer source (1, oddLength);
+	for (std::size_t i = 0; i < oddLength; ++i){
+		source.getFrames()[i] = static_cast<float>(std::sin(2.0 * std::numbers::pi * 5.0 * static_cast<double>(i) / oddLength));
+	}
+	source.fillGuards();
+	auto const pyramid = gran::SourcePyramid::build(source.view(), []{ return false; });
+	gran::SourceLevels const withOctaves {source.view(), pyramid.get()};
+	gran::SourceLevels const withoutOctaves {source.view(), nullptr};
+	gran::GrainWindowTable const windowTable;
+	for (auto const engine : {gran::GrainEngine::scalar, gran::GrainEngine::structureOfArrays}){
+		gran::GrainPool pool (8, windowTable);
+		pool.setEngine(engine);
+		std::mt19937 rng (41);
+		gran::GrainSpawn spawn;
+		spawn.window_length = 6.0 * blocksPerStretch * blockSize;	// the three stretches end on its peak
+		spawn.index_origin = 3.0;
+		spawn.index_rate = 4.0;
+		spawn.amplitude = 1.f;
+		spawn.gain_L = 1.f;
+		spawn.gain_R = 0.f;
+		pool.start(*pool.acquire(0, 0, rng), spawn, withOctaves);	// spawner 0 reads the second octave, on the left
+		std::swap(spawn.gain_L, spawn.gain_R);
+		pool.start(*pool.acquire(0, 1, rng), spawn, withoutOctaves);	// spawner 1 level 0, on the right
+
+		std::vector<float> L (blockSize), R (blockSize);
+		double worst {0.0};
+		float worstRead {0.f};
+		auto stretch = [&](){
+			for (int b = 0; b < blocksPerStretch; ++b){
+				std::fill(L.begin(), L.end(), 0.f);
+				std::fill(R.begin(), R.end(), 0.f);
+				pool.render(0, L.data(), R.data(), blockSize);
+				worstRead = std::max(worstRead, maxDifference(L, R));
+			}
+			std::array<gran::GrainDescription, 2> described {};
+			pool.describe(0, described, oddLength);
+			double const drift = std::abs(described[0].position - described[1].position);
+			worst = std::max(worst, (described[0].busy && described[1].busy) ? std::min(drift, 1.0 - drift) : 1.0);
+		};
+		stretch();
+		pool.retarget(withoutOctaves);
+		stretch();
+		pool.retarget(withOctaves);
+		stretch();
+		std::printf("  grain two octaves up on %zu frames (%s): worst drift from level 0 %.2e of the source, read difference %.2e\n",
+					oddLength, (engine == gran::GrainEngine::scalar) ? "scalar" : "structureOfArrays", worst, worstRead);
+		checks.expect((worst < 1e-9) && (worstRead < 0.01f),
+					  (engine == gran::GrainEngine::scalar) ? "a transposed scalar grain stays phase-locked to level 0"
+														 : "a transposed structureOfArrays grain stays phase-locked to level 0");
+	}
+}
+}	// namespace
+
+/**
+ The batched Hermite gather, AVX2 where the CPU has it, against the per-sample gen::peek it replaced in the renderer,
+ the guarded scalar read, and its own portable loop; in both the double-index and the split whole/fraction form.
+ Then the other qualities: sinc against Hermite on a high sine, linear against a plain lerp, and a transposed grain's read
+ of the source's octaves, and its phase against level 0's.
+ */
+void runInterpolationBench(Checks &checks){
+	std::printf("Hermite reads, %d grains x %zu reads (AVX2 %s)\n", numGrains, readsPerGrain,
+				gran::interp::usesAVX2() ? "available" : "unavailable: the dispatched rows time the portable loop");
+	
+	auto const source = makeSource();
+	float const *const wave = source.view().frames;
+	auto const indices = makeIndices();
+	std::vector<std::int32_t> wholes (numReads);
+	std::vector<float> fracs (numReads);
+	for (std::size_t i = 0; i < numReads; ++i){
+		double const whole = std::floor(indices[i]);
+		wholes[i] = static_cast<std::int32_t>(whole);
+		fracs[i] = static_cast<float>(indices[i] - whole);
+	}
+	
+	std::vector<float> peeked (numReads), scalar (numReads), portable (numReads), dispatched (numReads),
+		portableSplit (numReads), dispatchedSplit (numReads);
+	
+	auto const report = [](char const *const name, double const ns, double const baseline){
+		std::printf("  %-34s %7.3f ns/read  %5.2fx\n", name, ns, baseline / ns);
+	};
+	double const peekNs = nanosecondsPerItem(numReads, repeats, [&]{
+		for (std::size_t i = 0; i < numReads; ++i){
+			peeked[i] = gen::peek<float, gen::interpolationModes_e::hermite, gen::boundsModes_e::wrap>(wave, indices[i], sourceLength);
+		}
+		consume(peeked.back());
+	});
+	report("gen::peek (scalar, wraps each tap)", peekNs, peekNs);
+	report("interp::hermiteRead (scalar)", nanosecondsPerItem(numReads, repeats, [&]{
+		for (std::size_t i = 0; i < numReads; ++i){
+			scalar[i] = gran::interp::hermiteRead(wave, sourceLength, indices[i]);
+		}
+		consume(scalar.back());
+	}), peekNs);
+	report("hermiteGatherPortable", nanosecondsPerItem(numReads, repeats, [&]{
+		hermiteGatherPortable(wave, sourceLength, indices.data(), portable.data(), numReads);
+		consume(portable.back());
+	}), peekNs);
+	report("hermiteGather", nanosecondsPerItem(numReads, repeats, [&]{
+		hermiteGather(wave, sourceLength, indices.data(), dispatched.data(), numReads);
+		consume(dispatched.back());
+	}), peekNs);
+	report("hermiteGatherPortable (split)", nanosecondsPerItem(numReads, repeats, [&]{
+		hermiteGatherPortable(wave, sourceLength, wholes.data(), fracs.data(), portableSplit.data(), numReads);
+		consume(portableSplit.back());
+	}), peekNs);
+	report("hermiteGather (split)", nanosecondsPerItem(numReads, repeats, [&]{
+		hermiteGather(wave, sourceLength, wholes.data(), fracs.data(), dispatchedSplit.data(), numReads);
+		consume(dispatchedSplit.back());
+	}), peekNs);
+	
+	// the split form rounds the fraction to float, so it is held to a looser bound
+	checks.expect(maxDifference(scalar, peeked) < 1e-5f, "hermiteRead matches gen::peek");
+	checks.expect(maxDifference(portable, peeked) < 1e-5f, "hermiteGatherPortable matches gen::peek");
+	checks.expect(maxDifference(dispatched, portable) < 1e-6f, "hermiteGather matches hermiteGatherPortable");
+	checks.expect(maxDifference(portableSplit, peeked) < 1e-4f, "split hermiteGatherPortable matches gen::peek");
+	checks.expect(maxDifference(dispatchedSplit, portableSplit) < 1e-6f, "split hermiteGather matches its portable loop");
+	
+	std::printf("\nInterpolation accuracy\n");
+	checkSincAccuracy(checks);
+	checkLinearReads(checks);
+	checkTransposedGrainReadsOctave(checks);
+	checkTransposedGrainStaysLocked(checks);
+}
+}	// namespace nvs::bench
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    RandomBench.cpp
+    Created: 17 Oct 2026 10:02:47pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+#include "Random.h"
+#include <array>
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace nvs::bench {
+
+namespace {
+using namespace nvs::rand;
+
+constexpr std::size_t numDraws {std::size_t{1} << 21};
+constexpr double toleranceSigmas {5.0};	// with fixed seeds the checks are deterministic; this only sets how strict they are
+
+/**
+ What a sampler is held to: its moments, its CDF, and some tail thresholds. A positive threshold checks the mass above it,
+ a negative one the mass below it.
+ */
+struct Target {
+	double mean;
+	double variance;
+	double fourthCentralMoment;	// for the standard error of the sample variance
+	std::function<double(double)> cdf;
+	std::vector<double> tails;
+};
+Target normalTarget(double const mu, double const sigma){
+	double const s4 = sigma * sigma * sigma * sigma;
+	return {
+		mu, sigma * sigma, 3.0 * s4,
+		[=](double const x){ return 0.5 * std::erfc(-(x - mu) / (sigma * std::numbers::sqrt2)); },
+		// the ziggurat's base strip and tail begin at R
+		{mu - 4.0 * sigma, mu - ziggurat::NormalTables::R * sigma, mu - 2.0 * sigma,
+		 mu + 2.0 * sigma, mu + ziggurat::NormalTables::R * sigma, mu + 4.0 * sigma}
+	};
+}
+Target exponentialTarget(double const mean){
+	double const m4 = mean * mean * mean * mean;
+	return {
+		mean, mean * mean, 9.0 * m4,
+		[=](double const x){ return (x <= 0.0) ? 0.0 : -std::expm1(-x / mean); },
+		{2.0 * mean, ziggurat::ExponentialTables::R * mean, 10.0 * mean}
+	};
+}
+
+/**
+ Mean and variance within toleranceSigmas standard errors, every tail's mass within toleranceSigmas binomial standard
+ deviations, and the Kolmogorov-Smirnov distance under its 0.1% critical value.
+ */
+void checkDistribution(Checks &checks, char const *const name, std::vector<double> samples, Target const &target){
+	auto const n = static_cast<double>(samples.size());
+	double sum {0.0};
+	for (double const x : samples){
+		sum += x;
+	}
+	double const mean = sum / n;
+	double squares {0.0};
+	for (double const x : samples){
+		squares += (x - mean) * (x - mean);
+	}
+	double const variance = squares / (n - 1.0);
+	
+	std::printf("  %s: mean %.5f (%.5f), variance %.5f (%.5f)\n", name, mean, target.mean, variance, target.variance);
+	char what[160];
+	std::snprintf(what, sizeof what, "%s mean", name);
+	checks.expect(std::abs(mean - target.mean) < toleranceSigmas * std::sqrt(target.variance / n), what);
+	double const varianceError = std::sqrt((target.fourthCentralMoment - target.variance * target.variance) / n);
+	std::snprintf(what, sizeof what, "%s variance", name);
+	checks.expect(std::abs(variance - target.variance) < toleranceSigmas * varianceError, what);
+	
+	for (double const t : target.tails){
+		bool const upper = (t > target.mean);
+		double const expected = upper ? 1.0 - target.cdf(t) : target.cdf(t);
+		std::size_t count {0};
+		for (double const x : samples){
+			count += upper ? (x > t) : (x < t);
+		}
+		double const mass = static_cast<double>(count) / n;
+		double const error = std::sqrt(expected * (1.0 - expected) / n);
+		std::snprintf(what, sizeof what, "%s P(x %s %.3f) = %.3e (%.3e)", name, upper ? ">" : "<", t, mass, expected);
+		checks.expect(std::abs(mass - expected) < toleranceSigmas * error + 1.0 / n, what);
+	}
+	
+	std::sort(samples.begin(), samples.end());
+	double distance {0.0};
+	for (std::size_t i = 0; i < samples.size(); ++i){
+		double const f = target.cdf(samples[i]);
+		distance = std::max({distance, static_cast<double>(i + 1) / n - f, f - static_cast<double>(i) / n});
+	}
+	double const critical = 1.949 / std::sqrt(n);	// alpha = 0.001
+	std::snprintf(what, sizeof what, "%s KS distance %.2e < %.2e", name, distance, critical);
+	checks.expect(distance < critical, what);
+}
+template <typename Draw>
+std::vector<double> draw(Draw &&next){
+	std::vector<double> samples (numDraws);
+	for (auto &x : samples){
+		x = next();
+	}
+	return samples;
+}
+
+template <typename Draw>
+double nanosecondsPerDraw(Draw &&next){
+	constexpr std::size_t perRun {std::size_t{1} << 20};
+	return nanosecondsPerItem(perRun, 10, [&]{
+		double sum {0.0};
+		for (std::size_t i = 0; i < perRun; ++i){
+			sum += next();
+		}
+		consume(static_cast<float>(sum));
+	});
+}
+void report(char const *const name, double const ns, double const baseline){
+	std::printf("  %-44s %6.2f ns/draw  %5.2fx\n", name, ns, baseline / ns);
+}
+
+// Philox4x32-10 known-answer vectors, from the Random123 distribution (kat_vectors)
+struct KnownAnswer {
+	PhiloxStream::Counter counter;
+	PhiloxStream::Key key;
+	PhiloxStream::Counter expected;
+};
+constexpr std::array<KnownAnswer, 3> philoxKnownAnswers {{
+	{{0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u}, {0x00000000u, 0x00000000u},
+	 {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}},
+	{{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu},
+	 {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}},
+	{{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u},
+	 {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}}
+}};
+}	// namespace
+
+/**
+ PhiloxStream's block function against the published known answers. The ziggurat samplers against the normal and
+ exponential distributions they stand in for, straight from a generator, through the ring-buffered wrappers the grains use,
+ and from a PhiloxStream; then their throughput against Box-Muller, inverse-transform sampling, and the standard library's
+ distributions over the same generator.
+ */
+void runRandomTests(Checks &checks){
+	std::printf("\nPhilox4x32-10 known answers\n");
+	for (auto const &answer : philoxKnownAnswers){
+		auto const block = PhiloxStream::generate(answer.counter, answer.key);
+		char what[96];
+		std::snprintf(what, sizeof what, "Philox4x32-10 of counter %08x..., key %08x %08x", answer.counter[0], answer.key[0], answer.key[1]);
+		checks.expect(block == answer.expected, what);
+	}
+	
+	std::printf("\nZiggurat samplers, %zu draws each\n", numDraws);
+	{
+		XoshiroCpp::Xoshiro256Plus gen (11);
+		checkDistribution(checks, "ziggurat::normal", draw([&]{ return ziggurat::normal(gen); }), normalTarget(0.0, 1.0));
+	}
+	{
+		PhiloxStream stream (12);
+		stream.seek(3, 1, 7);
+		checkDistribution(checks, "ziggurat::normal (Philox)", draw([&]{ return ziggurat::normal(stream); }), normalTarget(0.0, 1.0));
+	}
+	{
+		GaussianZiggurat gaussian (13);
+		checkDistribution(checks, "GaussianZiggurat(2, 0.5)", draw([&]{ return gaussian(2.0, 0.5); }), normalTarget(2.0, 0.5));
+	}
+	{
+		XoshiroCpp::Xoshiro256Plus gen (14);
+		checkDistribution(checks, "ziggurat::exponential", draw([&]{ return ziggurat::exponential(gen); }), exponentialTarget(1.0));
+	}
+	{
+		PhiloxStream stream (15);
+		stream.seek(3, 2, 7);
+		checkDistribution(checks, "ziggurat::exponential (Philox)", draw([&]{ return ziggurat::exponential(stream); }),
+						  exponentialTarget(1.0));
+	}
+	{
+		ExponentialZiggurat exponential (16);
+		checkDistribution(checks, "ExponentialZiggurat(0.25, 1)", draw([&]{ return exponential(0.25, 1.0); }),
+						  exponentialTarget(0.25));
+	}
+	
+	std::printf("\nNormal draws\n");
+	{
+		BoxMuller boxMuller (21);
+		double const baseline = nanosecondsPerDraw([&]{ return boxMuller.nowaste_pol(0.0, 1.0); });
+		report("BoxMuller::nowaste_pol (polar, per call)", baseline, baseline);
+		report("BoxMuller (polar, ring)", nanosecondsPerDraw([&]{ return boxMuller(0.0, 1.0); }), baseline);
+		XoshiroCpp::Xoshiro256Plus gen (21);
+		std::normal_distribution<double> standard;
+		report("std::normal_distribution", nanosecondsPerDraw([&]{ return standard(gen); }), baseline);
+		report("ziggurat::normal", nanosecondsPerDraw([&]{ return ziggurat::normal(gen); }), baseline);
+		GaussianZiggurat gaussian (21);
+		report("GaussianZiggurat (ring)", nanosecondsPerDraw([&]{ return gaussian(0.0, 1.0); }), baseline);
+		PhiloxStream stream (21);
+		report("ziggurat::normal (Philox)", nanosecondsPerDraw([&]{ return ziggurat::normal(stream); }), baseline);
+	}
+	std::printf("\nExponential draws\n");
+	{
+		ExponentialRandomNumberGenerator inverse (22);
+		double const baseline = nanosecondsPerDraw([&]{ return inverse(1.0); });
+		report("ExponentialRandomNumberGenerator (-log u)", baseline, baseline);
+		ExponentialRandomNumberGeneratorWithVariance ring (22);
+		report("ExponentialRandomNumberGeneratorWithVariance", nanosecondsPerDraw([&]{ return ring(1.0, 1.0); }), baseline);
+		XoshiroCpp::Xoshiro256Plus gen (22);
+		std::exponential_distribution<double> standard;
+		report("std::exponential_distribution", nanosecondsPerDraw([&]{ return standard(gen); }), baseline);
+		report("ziggurat::exponential", nanosecondsPerDraw([&]{ return ziggurat::exponential(gen); }), baseline);
+		ExponentialZiggurat exponential (22);
+		report("ExponentialZiggurat (ring)", nanosecondsPerDraw([&]{ return exponential(1.0, 1.0); }), baseline);
+	}
+}
+}	// namespace nvs::bench
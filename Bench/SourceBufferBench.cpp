@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    SourceBufferBench.cpp
+    Created: 18 Oct 2026 4:37:52pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+#include "Synthesis/Interpolation.h"
+#include "Synthesis/SourceBuffer.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace nvs::bench {
+
+namespace {
+using namespace nvs::gran;
+using interp::Quality;
+
+constexpr std::array<std::size_t, 7> lengths {1, 3, 7, 15, 17, 100, 1000};	// the first four shorter than interp::guardFrames
+constexpr std::size_t readsPerCase {37};	// not a multiple of 8, so the vector kernels' tails are read as well
+constexpr float tolerance {1e-5f};
+
+/**
+ One channel of a source, unpadded, read by wrapping every tap into it on its own: what the guard frames must reproduce.
+ */
+struct Reference {
+	std::vector<float> samples;
+
+	float at(long long const i) const {
+		auto const n = static_cast<long long>(samples.size());
+		return samples[static_cast<std::size_t>(((i % n) + n) % n)];
+	}
+	float read(Quality const quality, double const index) const {
+		double const whole_d = std::floor(index);
+		auto const whole = static_cast<long long>(whole_d);
+		auto const frac = static_cast<float>(index - whole_d);
+		switch (quality){
+			case Quality::linear:
+				return at(whole) + frac * (at(whole + 1) - at(whole));
+			case Quality::hermite: {
+				float const y0 = at(whole - 1), y1 = at(whole), y2 = at(whole + 1), y3 = at(whole + 2);
+				float const c1 = 0.5f * (y2 - y0);
+				float const c2 = y0 - 2.5f * y1 + 2.f * y2 - 0.5f * y3;
+				float const c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+				return ((c3 * frac + c2) * frac + c1) * frac + y1;
+			}
+			case Quality::sinc: {
+				constexpr int taps {interp::SincTable::taps};
+				auto const &table = interp::sincTable();
+				float const position = frac * static_cast<float>(interp::SincTable::numPhases);
+				int const p = std::min(static_cast<int>(position), interp::SincTable::numPhases - 1);
+				float const t = position - static_cast<float>(p);
+				float sum {0.f};
+				for (int k = 0; k < taps; ++k){
+					float const c = table.phase(p)[k] + t * (table.phase(p + 1)[k] - table.phase(p)[k]);
+					sum += c * at(whole + k - (taps / 2 - 1));
+				}
+				return sum;
+			}
+		}
+		return 0.f;
+	}
+};
+
+/**
+ Alternately inside [0, n) and well outside it on either side, as of a grain running past its read bounds; the wholes are
+ left unwrapped, so that the split forms are handed out-of-range wholes too.
+ */
+void makePositions(std::size_t const n, std::mt19937 &engine, std::vector<double> &indices,
+				   std::vector<std::int32_t> &wholes, std::vector<float> &fracs){
+	auto const length = static_cast<double>(n);
+	std::uniform_real_distribution<double> inside (0.0, length);
+	std::uniform_real_distribution<double> outside (-3.0 * length, 4.0 * length);
+	for (std::size_t i = 0; i < readsPerCase; ++i){
+		indices[i] = (i % 2 == 0) ? inside(engine) : outside(engine);
+		double const whole = std::floor(indices[i]);
+		wholes[i] = static_cast<std::int32_t>(whole);
+		fracs[i] = static_cast<float>(indices[i] - whole);
+	}
+}
+}	// namespace
+
+/**
+ SourceBuffer's guard frames against a modular-wrap reference: for sources shorter than interp::guardFrames as well as longer,
+ mono and stereo, the guards must be the frames at the other end, wrapped as many times as it takes, and every read, of each
+ Quality, in each form, at positions inside and outside the source, must match the same read with every tap wrapped on its own.
+ */
+void runSourceBufferTests(Checks &checks){
+	std::mt19937 engine (23);
+	std::uniform_real_distribution<float> noise (-1.f, 1.f);
+	auto const guard = static_cast<long long>(interp::guardFrames);
+
+	bool guardsWrap {true};
+	bool copiesKeepGuards {true};
+	float worstMono {0.f};
+	float worstStereo {0.f};
+	std::vector<double> indices (readsPerCase);
+	std::vector<std::int32_t> wholes (readsPerCase);
+	std::vector<float> fracs (readsPerCase);
+	std::vector<float> L (readsPerCase);
+	std::vector<float> R (readsPerCase);
+	for (std::size_t const n : lengths){
+		for (int const numChannels : {1, 2}){
+			SourceBuffer source (numChannels, n);
+			std::vector<Reference> channels (static_cast<std::size_t>(numChannels));
+			for (std::size_t i = 0; i < n; ++i){
+				for (int c = 0; c < numChannels; ++c){
+					float const x = noise(engine);
+					source.getFrames()[i * static_cast<std::size_t>(numChannels) + static_cast<std::size_t>(c)] = x;
+					channels[static_cast<std::size_t>(c)].samples.push_back(x);
+				}
+			}
+			source.fillGuards();
+			auto const view = source.view();
+			SourceBuffer const copy (view);
+			auto const copied = copy.view();
+			for (long long i = -guard; i < static_cast<long long>(n) + guard; ++i){
+				for (int c = 0; c < numChannels; ++c){
+					float const frame = view.frames[i * numChannels + c];
+					guardsWrap = guardsWrap && (frame == channels[static_cast<std::size_t>(c)].at(i));
+					copiesKeepGuards = copiesKeepGuards && (copied.frames[i * numChannels + c] == frame);
+				}
+			}
+
+			makePositions(n, engine, indices, wholes, fracs);
+			auto compare = [&](float &worst, Reference const &channel, Quality const quality, std::vector<float> const &out){
+				for (std::size_t i = 0; i < readsPerCase; ++i){
+					worst = std::max(worst, std::abs(out[i] - channel.read(quality, indices[i])));
+				}
+			};
+			auto readAll = [&]<Quality Q>(){
+				if (numChannels == 1){
+					interp::gather<Q>(view.frames, n, indices.data(), L.data(), readsPerCase);
+					compare(worstMono, channels[0], Q, L);
+					interp::gather<Q>(view.frames, n, wholes.data(), fracs.data(), L.data(), readsPerCase);
+					compare(worstMono, channels[0], Q, L);
+				} else {
+					interp::gatherStereo<Q>(view.frames, n, indices.data(), L.data(), R.data(), readsPerCase);
+					compare(worstStereo, channels[0], Q, L);
+					compare(worstStereo, channels[1], Q, R);
+					interp::gatherStereo<Q>(view.frames, n, wholes.data(), fracs.data(), L.data(), R.data(), readsPerCase);
+					compare(worstStereo, channels[0], Q, L);
+					compare(worstStereo, channels[1], Q, R);
+				}
+			};
+			readAll.template operator()<Quality::linear>();
+			readAll.template operator()<Quality::hermite>();
+			readAll.template operator()<Quality::sinc>();
+			if (numChannels == 1){
+				for (std::size_t i = 0; i < readsPerCase; ++i){
+					L[i] = interp::linearRead(view.frames, n, indices[i]);
+				}
+				compare(worstMono, channels[0], Quality::linear, L);
+				for (std::size_t i = 0; i < readsPerCase; ++i){
+					L[i] = interp::hermiteRead(view.frames, n, indices[i]);
+				}
+				compare(worstMono, channels[0], Quality::hermite, L);
+				for (std::size_t i = 0; i < readsPerCase; ++i){
+					L[i] = interp::sincRead(view.frames, n, indices[i]);
+				}
+				compare(worstMono, channels[0], Quality::sinc, L);
+			}
+		}
+	}
+	std::printf("\nSource buffer guards, %zu to %zu frames (guardFrames %zu): worst read error mono %.2e, stereo %.2e\n",
+				lengths.front(), lengths.back(), interp::guardFrames, worstMono, worstStereo);
+	checks.expect(guardsWrap, "the guard frames are the source wrapped, however short it is");
+	checks.expect(copiesKeepGuards, "a copied source carries the same guard frames");
+	checks.expect(worstMono < tolerance, "mono reads inside and outside the source match wrapping every tap");
+	checks.expect(worstStereo < tolerance, "stereo reads inside and outside the source match wrapping every tap");
+}
+}	// namespace nvs::bench
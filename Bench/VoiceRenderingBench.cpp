@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    VoiceRenderingBench.cpp
+    Created: 18 Oct 2026 10:02:17am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+#include "Synthesis/GranularSynthesizer.h"
+#include "Params/params.h"
+#include <JuceHeader.h>
+#include <random>
+#include <vector>
+
+namespace nvs::bench {
+
+namespace {
+using namespace nvs::gran;
+using VoiceRendering = GranularSynthesizer::VoiceRendering;
+
+constexpr double sampleRate {48000.0};
+constexpr int blockSize {256};
+constexpr int numBlocks {400};
+constexpr int noteOffBlock {numBlocks / 2};	// one note is released halfway, so a voice renders its tail
+constexpr int numVoices {4};
+constexpr int grainsPerVoice {8};
+
+// the least AudioProcessor that can own the synth's parameters
+class ParameterHost	:	public juce::AudioProcessor {
+public:
+	ParameterHost()	:	AudioProcessor(BusesProperties().withOutput("Output", juce::AudioChannelSet::stereo(), true))	{}
+	const juce::String getName() const override { return "synthesis-bench"; }
+	void prepareToPlay(double, int) override {}
+	void releaseResources() override {}
+	void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override {}
+	double getTailLengthSeconds() const override { return 0.0; }
+	bool acceptsMidi() const override { return true; }
+	bool producesMidi() const override { return false; }
+	juce::AudioProcessorEditor *createEditor() override { return nullptr; }
+	bool hasEditor() const override { return false; }
+	int getNumPrograms() override { return 1; }
+	int getCurrentProgram() override { return 0; }
+	void setCurrentProgram(int) override {}
+	const juce::String getProgramName(int) override { return {}; }
+	void changeProgramName(int, const juce::String &) override {}
+	void getStateInformation(juce::MemoryBlock &) override {}
+	void setStateInformation(const void *, int) override {}
+};
+
+juce::AudioProcessorValueTreeState::ParameterLayout makeParameterLayout(){	// the parameters the synth reads; no choices, no groups
+	juce::AudioProcessorValueTreeState::ParameterLayout layout;
+	for (auto const &pd : nvs::param::ALL_PARAMETERS){
+		if (pd.getParameterType() == nvs::param::ParameterType::Float){
+			auto const &elements = std::get<nvs::param::ParameterDef::FloatParamElements>(pd.elementsVar);
+			layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{pd.ID, 1}, pd.displayName,
+																   pd.getFloatRange(), elements.defaultVal));
+		}
+	}
+	return layout;
+}
+void setParameter(juce::AudioProcessorValueTreeState &apvts, char const *const id, float const value){
+	auto *const parameter = apvts.getParameter(id);
+	jassert (parameter != nullptr);
+	parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+struct Render {
+	std::vector<float> L, R;
+	bool parallel {false};	// whether the synth actually rendered its voices in parallel
+	bool saturated {false};	// whether a voice ever filled its partition of the grain pool, so that onsets were dropped
+	double millisecondsPerBlock {0.0};
+};
+/**
+ numBlocks of four held notes, one released halfway. The grains are dense and long (at the top speed, each lasting half the
+ source), so every voice's partition of the pool fills and drops onsets; and untransposed, so no grain reads an octave, which
+ the builder thread installs whenever it finishes.
+ */
+Render render(juce::AudioProcessorValueTreeState &apvts, juce::AudioBuffer<float> &source, VoiceRendering const mode){
+	GranularSynthesizer synth (apvts);
+	synth.setLogger([](juce::String const &){});
+	synth.setCurrentPlaybackSampleRate(sampleRate);
+	synth.setVoiceAndGrainCounts(numVoices, grainsPerVoice);
+	synth.setRandomStreams(RandomStreams::counterBased, 0x5eedu);
+	synth.setVoiceRendering(mode, numVoices - 1, blockSize);
+	for (int v = 0; v < synth.getNumVoices(); ++v){
+		if (auto *const voice = dynamic_cast<GranularVoice *>(synth.getVoice(v))){
+			voice->prepareToPlay(sampleRate, blockSize);
+		}
+	}
+	synth.setAudioBuffer(source, sampleRate, 0);
+
+	Render result;
+	result.parallel = (synth.getVoiceRendering() == VoiceRendering::parallel);
+	auto const &pool = synth.viewSynthSharedState()._grain_pool;
+	std::size_t const partitionSize = pool.getCapacity() / pool.getNumPartitions();
+
+	juce::AudioBuffer<float> block (2, blockSize);
+	juce::MidiBuffer midi;
+	using clock = std::chrono::steady_clock;
+	auto const start = clock::now();
+	for (int b = 0; b < numBlocks; ++b){
+		midi.clear();
+		if (b == 0){
+			for (int const note : {57, 60, 64, 67}){
+				midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), 0);
+			}
+		} else if (b == noteOffBlock){
+			midi.addEvent(juce::MidiMessage::noteOff(1, 60), blockSize / 3);
+		}
+		block.clear();
+		synth.processBlock(block, midi);
+		result.L.insert(result.L.end(), block.getReadPointer(0), block.getReadPointer(0) + blockSize);
+		result.R.insert(result.R.end(), block.getReadPointer(1), block.getReadPointer(1) + blockSize);
+		for (int v = 0; v < numVoices; ++v){
+			result.saturated = result.saturated || (pool.getNumActive(v) == partitionSize);
+		}
+	}
+	std::chrono::duration<double, std::milli> const elapsed = clock::now() - start;
+	result.millisecondsPerBlock = elapsed.count() / numBlocks;
+	return result;
+}
+}	// namespace
+
+/**
+ With counter-based random streams, rendering voices on the workers must not change a single sample: each voice draws from
+ streams keyed by its own grains, fills only its own partition of the grain pool, and the voices are summed in voice order.
+ The full synth is rendered both ways from the same MIDI and compared exactly; with fewer than two CPUs setVoiceRendering
+ falls back to sequential, and the comparison is skipped.
+ */
+void runVoiceRenderingBench(Checks &checks){
+	juce::ScopedJuceInitialiser_GUI const messageManager;	// the parameter state's timer wants one
+	ParameterHost host;
+	juce::AudioProcessorValueTreeState apvts (host, nullptr, "PLUGIN_STATE", makeParameterLayout());
+	setParameter(apvts, "speed", 1000.f);
+	setParameter(apvts, "duration", 0.5f);
+	setParameter(apvts, "position_rand", 0.2f);
+	setParameter(apvts, "duration_rand", 0.2f);
+	setParameter(apvts, "pan_rand", 0.5f);
+	setParameter(apvts, "transpose_rand", 0.f);
+
+	juce::AudioBuffer<float> source (2, static_cast<int>(sampleRate));
+	std::mt19937 engine (13);
+	std::uniform_real_distribution<float> noise (-1.f, 1.f);
+	for (int c = 0; c < source.getNumChannels(); ++c){
+		for (int i = 0; i < source.getNumSamples(); ++i){
+			source.setSample(c, i, noise(engine));
+		}
+	}
+
+	auto const sequential = render(apvts, source, VoiceRendering::sequential);
+	auto const parallel = render(apvts, source, VoiceRendering::parallel);
+	std::printf("\nVoice rendering, %d voices x %d grains, counter-based streams: sequential %.3f ms per %d-sample block",
+				numVoices, grainsPerVoice, sequential.millisecondsPerBlock, blockSize);
+	if (!parallel.parallel){
+		std::printf("; parallel skipped (fewer than two CPUs)\n");
+		return;
+	}
+	std::printf(", parallel %.3f ms\n", parallel.millisecondsPerBlock);
+
+	std::size_t differing {0};
+	bool sounding {false};
+	for (std::size_t i = 0; i < sequential.L.size(); ++i){
+		differing += (sequential.L[i] != parallel.L[i]) || (sequential.R[i] != parallel.R[i]);
+		sounding = sounding || (sequential.L[i] != 0.f);
+	}
+	checks.expect(sounding && sequential.saturated && parallel.saturated, "the voices sound, and fill their pool partitions");
+	checks.expect(differing == 0, "a parallel counter-based render is sample for sample the sequential one");
+}
+}	// namespace nvs::bench
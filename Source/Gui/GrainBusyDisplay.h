@@ -17,13 +17,28 @@ class GrainBusyDisplay	:	public juce::Component
 	// needs to paint squares
 	// lit up if the corresponding grain is active,
 	// otherwise just the outline
-	// from outside, the dimensions this is given should be S * N_GRAINS, S * N_VOICES
+	// from outside, the dimensions this is given should be S * numGrains, S * numVoices
 {
 public:	
 	void paint(juce::Graphics &g) override;
 	void resized() override;
 	
+	bool setDimensions(size_t numVoices, size_t numGrains){	// returns whether they changed
+		if ((numVoices == _num_voices) && (numGrains == _num_grains)){
+			return false;
+		}
+		_num_voices = numVoices;
+		_num_grains = numGrains;
+		_statuses.assign(_num_voices * _num_grains, false);
+		return true;
+	}
+	size_t getNumVoices() const { return _num_voices; }
+	size_t getNumGrains() const { return _num_grains; }
+	
 	void setStatus(int grain, int voice, bool status){
+		if ((grain < 0) || (voice < 0) || (static_cast<size_t>(grain) >= _num_grains) || (static_cast<size_t>(voice) >= _num_voices)){
+			return;	// e.g. descriptions measured before the synth was rebuilt with fewer voices or grains
+		}
 		_statuses[getIndex(voice, grain)] = status;
 	}
 	void setSizePerGrain(float s) {
@@ -38,7 +53,7 @@ private:
 	float _sizePerGrain  {0};
 	
 	size_t getIndex(size_t voice, size_t grain) {
-		size_t idx = voice * N_GRAINS + grain;
+		size_t idx = voice * _num_grains + grain;
 		return idx;
 	}
 	struct VoiceAndGrain {
@@ -47,10 +62,12 @@ private:
 	};
 	VoiceAndGrain getVoiceAndGrain(size_t idx){
 		return VoiceAndGrain {
-			.voice = idx / N_GRAINS,
-			.grain = idx % N_GRAINS
+			.voice = idx / _num_grains,
+			.grain = idx % _num_grains
 		};
 	}
 	
-	std::array<bool, N_GRAINS * N_VOICES> _statuses {};
+	size_t _num_voices {N_VOICES};
+	size_t _num_grains {N_GRAINS};
+	std::vector<bool> _statuses = std::vector<bool>(N_VOICES * N_GRAINS, false);
 };
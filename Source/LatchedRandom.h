@@ -35,9 +35,19 @@ requires(T t, T const ct, bool gate, float_t mu, float_t sigma)
 	{ ct.getSigma() } -> std::same_as<float_t>;
 };
 
-template<std::floating_point float_t>
+/**
+ What a latched random needs from its generator: rng(mu, sigma) for a Gaussian, rng(mu, variance) for an exponential.
+ BoxMuller, ExponentialRandomNumberGeneratorWithVariance and the ziggurat generators all qualify.
+ */
+template <typename T>
+concept MuSigmaGenerator = requires(T rng, double mu, double sigma)
+{
+	{ rng(mu, sigma) } -> std::convertible_to<double>;
+};
+
+template<std::floating_point float_t, MuSigmaGenerator Rng = BoxMuller>
 struct LatchedGaussianRandom {
-	LatchedGaussianRandom(BoxMuller &rng, MuSigmaPair<float_t> msp)
+	LatchedGaussianRandom(Rng &rng, MuSigmaPair<float_t> msp)
 	:	_rng(rng), _val(msp.mu), _msp(msp){}
 	
 	float_t operator()(bool gate){
@@ -59,15 +69,15 @@ struct LatchedGaussianRandom {
 	float_t getSigma() const {
 		return _msp.sigma;
 	}
-	BoxMuller &_rng;
+	Rng &_rng;
 private:
 	float_t _val;
 	MuSigmaPair<float_t> _msp;
 };
 
-template<std::floating_point float_t>
+template<std::floating_point float_t, MuSigmaGenerator Rng = ExponentialRandomNumberGeneratorWithVariance>
 struct LatchedExponentialRandomWithSigma {
-	LatchedExponentialRandomWithSigma(ExponentialRandomNumberGeneratorWithVariance &rng, MuSigmaPair<float_t> msp)
+	LatchedExponentialRandomWithSigma(Rng &rng, MuSigmaPair<float_t> msp)
 	:	_rng(rng), _val(msp.mu), _msp(msp)
 	{}
 	float_t operator()(bool gate){
@@ -88,22 +98,22 @@ struct LatchedExponentialRandomWithSigma {
 	float_t getSigma() const {
 		return _msp.sigma;
 	}
-	ExponentialRandomNumberGeneratorWithVariance &_rng;
+	Rng &_rng;
 private:
 	float_t _val;
 	MuSigmaPair<float_t> _msp;
 };
 
-template <typename float_t>
+template <typename float_t, MuSigmaGenerator Rng>
 requires std::floating_point<float_t>
-LatchedGaussianRandom<float_t> createLatchedGaussianRandom(BoxMuller &rng, MuSigmaPair<float_t> msp) {
-    return LatchedGaussianRandom<float_t>(rng, msp);
+LatchedGaussianRandom<float_t, Rng> createLatchedGaussianRandom(Rng &rng, MuSigmaPair<float_t> msp) {
+    return LatchedGaussianRandom<float_t, Rng>(rng, msp);
 }
 
-template <typename float_t>
+template <typename float_t, MuSigmaGenerator Rng>
 requires std::floating_point<float_t>
-LatchedExponentialRandomWithSigma<float_t> createLatchedExponentialRandom(ExponentialRandomNumberGeneratorWithVariance &rng, MuSigmaPair<float_t> msp) {
-    return LatchedExponentialRandomWithSigma<float_t>(rng, msp);
+LatchedExponentialRandomWithSigma<float_t, Rng> createLatchedExponentialRandom(Rng &rng, MuSigmaPair<float_t> msp) {
+    return LatchedExponentialRandomWithSigma<float_t, Rng>(rng, msp);
 }
 
 class ClassThatNeedsRandomness {
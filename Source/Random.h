@@ -10,8 +10,49 @@
 
 #pragma once
 #include "XoshiroCpp.hpp"
+#include <array>
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 namespace nvs::rand {
 
+/**
+ A ring of pre-generated samples. next() is a read; the consumed part of the ring is regenerated in bulk by refill(),
+ which the owner calls off the latching path (e.g. once per audio block). If the ring runs dry, next() refills it itself.
+ */
+template <std::size_t Capacity>
+class SampleRing {
+public:
+	template <typename Generate>	// void(double *out, std::size_t count)
+	void refill(Generate &&generate){
+		std::size_t write = (_read + _available) % Capacity;
+		std::size_t remaining = Capacity - _available;
+		while (remaining > 0){
+			std::size_t const n = std::min(remaining, Capacity - write);
+			generate(_buffer.data() + write, n);
+			write = (write + n) % Capacity;
+			remaining -= n;
+		}
+		_available = Capacity;
+	}
+	template <typename Generate>
+	double next(Generate &&generate){
+		if (_available == 0){
+			refill(generate);
+		}
+		double const x = _buffer[_read];
+		_read = (_read + 1) % Capacity;
+		--_available;
+		return x;
+	}
+private:
+	std::array<double, Capacity> _buffer {};
+	std::size_t _read {0};
+	std::size_t _available {0};
+};
+
 struct RandomNumberGenerator {
 public:
 	RandomNumberGenerator(unsigned long seed = 1234567890UL)	:	xosh(seed){}
@@ -55,26 +96,41 @@ private:
 
 struct ExponentialRandomNumberGeneratorWithVariance {
 public:
+	static constexpr std::size_t ringSize {256};
+	
 	ExponentialRandomNumberGeneratorWithVariance(unsigned long seed = 1234567890UL)
 	: rng(seed) {}
 	double operator()(double mu, double variance) {
-		auto const lambda = 1.0 / mu;
-		auto const expRandom = rng(lambda);
+		auto const expRandom = mu * exponentials.next([this](double *out, std::size_t n){ generate(out, n); });	// exponential with rate 1 / mu
 		return (variance * expRandom) + ((1.0 - variance) * mu);
 	}
+	void refill() {
+		exponentials.refill([this](double *out, std::size_t n){ generate(out, n); });
+	}
 	XoshiroCpp::Xoshiro256Plus &getGenerator() {
 		return rng.getGenerator();
 	}
 private:
 	ExponentialRandomNumberGenerator rng;
+	SampleRing<ringSize> exponentials;	// rate 1
+	
+	void generate(double *out, std::size_t count) {
+		for (std::size_t i = 0; i < count; ++i){
+			out[i] = rng(1.0);
+		}
+	}
 };
 
 struct BoxMuller {
+	static constexpr std::size_t ringSize {256};
+	
 	BoxMuller(unsigned long seed = 1234567890UL)
 	:	rng(seed){}
-	double operator()(double mu, double sigma){
-		return polar(mu, sigma).first;
-//		return nowaste_pol(mu, sigma);
+	double operator()(double mu, double sigma){	// reads a pre-generated standard normal
+		return mu + sigma * normals.next([this](double *out, std::size_t n){ generate(out, n); });
+	}
+	void refill(){	// regenerates whatever operator() has consumed, using both values of every polar pair
+		normals.refill([this](double *out, std::size_t n){ generate(out, n); });
 	}
 	XoshiroCpp::Xoshiro256Plus &getGenerator(){
 		return rng.getGenerator();
@@ -113,6 +169,17 @@ private:
 	RandomNumberGenerator rng;
 	unsigned int count {0};
 	double next;
+	SampleRing<ringSize> normals;	// mu 0, sigma 1
+	
+	void generate(double *out, std::size_t n){
+		for (std::size_t i = 0; i < n; i += 2){
+			auto const [z0, z1] = polar(0.0, 1.0);
+			out[i] = z0;
+			if (i + 1 < n){
+				out[i + 1] = z1;
+			}
+		}
+	}
 	
 	std::pair<double, double> standard(double mu, double sigma){
 		constexpr double eps = std::numeric_limits<double>::epsilon();
@@ -147,4 +214,234 @@ private:
 	}
 };
 
+/**
+ A counter-based generator (Philox4x32-10; Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011).
+ Each output is a pure function of the key (the seed) and a 128-bit counter, which seek() lays out as
+ (voice, stream, event, draw index). A stream positioned at the same place therefore yields the same numbers whichever
+ thread draws them, and however draws on other streams are interleaved with it.
+ Satisfies UniformRandomBitGenerator, 64 bits per call.
+ */
+class PhiloxStream {
+public:
+	using result_type = std::uint64_t;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+	
+	using Counter = std::array<std::uint32_t, 4>;
+	using Key = std::array<std::uint32_t, 2>;
+	
+	PhiloxStream(std::uint64_t seed = 1234567890UL){
+		setSeed(seed);
+	}
+	void setSeed(std::uint64_t seed){
+		_key = {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+	}
+	void seek(std::uint32_t voice, std::uint32_t stream, std::uint32_t event){
+		_counter = {0, stream, voice, event};
+		_available = 0;
+	}
+	result_type operator()(){
+		if (_available == 0){
+			_block = generate(_counter, _key);
+			++_counter[0];
+			_available = 2;
+		}
+		std::size_t const i = 2 - _available--;
+		return (static_cast<std::uint64_t>(_block[2 * i]) << 32) | _block[2 * i + 1];
+	}
+	static Counter generate(Counter c, Key k){
+		for (int round = 0; round < 10; ++round){
+			if (round > 0){
+				k[0] += 0x9E3779B9u;
+				k[1] += 0xBB67AE85u;
+			}
+			std::uint64_t const p0 = static_cast<std::uint64_t>(0xD2511F53u) * c[0];
+			std::uint64_t const p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * c[2];
+			c = {
+				static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0],
+				static_cast<std::uint32_t>(p1),
+				static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1],
+				static_cast<std::uint32_t>(p0)
+			};
+		}
+		return c;
+	}
+private:
+	Key _key {};
+	Counter _counter {};
+	Counter _block {};
+	std::size_t _available {0};	// 64-bit outputs left in _block
+};
+
+/**
+ Ziggurat sampling (Marsaglia & Tsang; the normal variant after Doornik, 2005): a table lookup and one compare for ~99% of draws,
+ with exp/log only on the wedges and the tail. Tables are built once per process.
+ */
+namespace ziggurat {
+struct NormalTables {
+	static constexpr int numLayers {128};
+	static constexpr double R {3.442619855899};
+	static constexpr double V {9.91256303526217e-3};
+	std::array<double, numLayers + 1> x;
+	std::array<double, numLayers> ratio;	// x[i + 1] / x[i]
+	NormalTables(){
+		auto const f = [](double v){ return std::exp(-0.5 * v * v); };
+		x[0] = V / f(R);
+		x[1] = R;
+		for (int i = 2; i < numLayers; ++i){
+			x[i] = std::sqrt(-2.0 * std::log(V / x[i - 1] + f(x[i - 1])));
+		}
+		x[numLayers] = 0.0;
+		for (int i = 0; i < numLayers; ++i){
+			ratio[i] = x[i + 1] / x[i];
+		}
+	}
+};
+struct ExponentialTables {
+	static constexpr int numLayers {256};
+	static constexpr double R {7.69711747013104972};
+	static constexpr double V {3.949659822581572e-3};
+	std::array<double, numLayers + 1> x;
+	std::array<double, numLayers + 1> f;	// exp(-x[i])
+	ExponentialTables(){
+		x[0] = V * std::exp(R);
+		x[1] = R;
+		for (int i = 2; i < numLayers; ++i){
+			x[i] = -std::log(V / x[i - 1] + std::exp(-x[i - 1]));
+		}
+		x[numLayers] = 0.0;
+		for (int i = 0; i <= numLayers; ++i){
+			f[i] = std::exp(-x[i]);
+		}
+	}
+};
+inline NormalTables const &normalTables(){
+	static NormalTables const tables;
+	return tables;
+}
+inline ExponentialTables const &exponentialTables(){
+	static ExponentialTables const tables;
+	return tables;
+}
+
+// one standard normal (mu 0, sigma 1); Gen is any generator of 64 random bits per call
+template <typename Gen>
+double normal(Gen &gen){
+	auto const &t = normalTables();
+	while (true){
+		std::uint64_t const bits = gen();
+		double const u = 2.0 * XoshiroCpp::DoubleFromBits(bits) - 1.0;	// top 53 bits
+		int const i = static_cast<int>((bits >> 4) & (NormalTables::numLayers - 1));	// bits below those, avoiding xoshiro256+'s weak lowest bits
+		if (std::abs(u) < t.ratio[i]){
+			return u * t.x[i];
+		}
+		if (i == 0){	// the tail beyond R
+			double x, y;
+			do {
+				x = std::log(XoshiroCpp::DoubleFromBits(gen()) + std::numeric_limits<double>::min()) / NormalTables::R;
+				y = std::log(XoshiroCpp::DoubleFromBits(gen()) + std::numeric_limits<double>::min());
+			} while (-2.0 * y < x * x);
+			return (u < 0.0) ? (x - NormalTables::R) : (NormalTables::R - x);
+		}
+		double const x = u * t.x[i];
+		double const f0 = std::exp(-0.5 * (t.x[i] * t.x[i] - x * x));
+		double const f1 = std::exp(-0.5 * (t.x[i + 1] * t.x[i + 1] - x * x));
+		if (f1 + XoshiroCpp::DoubleFromBits(gen()) * (f0 - f1) < 1.0){
+			return x;
+		}
+	}
+}
+// one standard exponential (rate 1)
+template <typename Gen>
+double exponential(Gen &gen){
+	auto const &t = exponentialTables();
+	while (true){
+		std::uint64_t const bits = gen();
+		double const u = XoshiroCpp::DoubleFromBits(bits);
+		int const i = static_cast<int>((bits >> 3) & (ExponentialTables::numLayers - 1));
+		double const x = u * t.x[i];
+		if (x < t.x[i + 1]){
+			return x;
+		}
+		if (i == 0){	// memoryless tail
+			return ExponentialTables::R - std::log(1.0 - XoshiroCpp::DoubleFromBits(gen()));
+		}
+		if (t.f[i + 1] + XoshiroCpp::DoubleFromBits(gen()) * (t.f[i] - t.f[i + 1]) < std::exp(-x)){
+			return x;
+		}
+	}
+}
+}	// namespace ziggurat
+
+/**
+ Drop-in replacement for BoxMuller: operator()(mu, sigma), backed by a ring of ziggurat normals.
+ */
+struct GaussianZiggurat {
+	static constexpr std::size_t ringSize {256};
+	
+	GaussianZiggurat(unsigned long seed = 1234567890UL)
+	:	rng(seed){}
+	double operator()(double mu, double sigma){
+		if (counterStream){
+			return mu + sigma * ziggurat::normal(*counterStream);
+		}
+		return mu + sigma * normals.next([this](double *out, std::size_t n){ generate(out, n); });
+	}
+	void refill(){
+		normals.refill([this](double *out, std::size_t n){ generate(out, n); });
+	}
+	void setCounterStream(PhiloxStream *stream){	// draw from stream rather than the ring; nullptr goes back to the ring
+		counterStream = stream;
+	}
+	XoshiroCpp::Xoshiro256Plus &getGenerator(){
+		return rng.getGenerator();
+	}
+private:
+	RandomNumberGenerator rng;
+	SampleRing<ringSize> normals;	// mu 0, sigma 1
+	PhiloxStream *counterStream {nullptr};
+	
+	void generate(double *out, std::size_t n){
+		for (std::size_t i = 0; i < n; ++i){
+			out[i] = ziggurat::normal(rng.getGenerator());
+		}
+	}
+};
+
+/**
+ Drop-in replacement for ExponentialRandomNumberGeneratorWithVariance: operator()(mu, variance), backed by a ring of
+ ziggurat exponentials.
+ */
+struct ExponentialZiggurat {
+	static constexpr std::size_t ringSize {256};
+	
+	ExponentialZiggurat(unsigned long seed = 1234567890UL)
+	:	rng(seed){}
+	double operator()(double mu, double variance){
+		double const standard = counterStream ? ziggurat::exponential(*counterStream)
+											  : exponentials.next([this](double *out, std::size_t n){ generate(out, n); });
+		auto const expRandom = mu * standard;	// exponential with rate 1 / mu
+		return (variance * expRandom) + ((1.0 - variance) * mu);
+	}
+	void refill(){
+		exponentials.refill([this](double *out, std::size_t n){ generate(out, n); });
+	}
+	void setCounterStream(PhiloxStream *stream){	// draw from stream rather than the ring; nullptr goes back to the ring
+		counterStream = stream;
+	}
+	XoshiroCpp::Xoshiro256Plus &getGenerator(){
+		return rng.getGenerator();
+	}
+private:
+	RandomNumberGenerator rng;
+	SampleRing<ringSize> exponentials;	// rate 1
+	PhiloxStream *counterStream {nullptr};
+	
+	void generate(double *out, std::size_t n){
+		for (std::size_t i = 0; i < n; ++i){
+			out[i] = ziggurat::exponential(rng.getGenerator());
+		}
+	}
+};
+
 }	// namespace nvs::rand
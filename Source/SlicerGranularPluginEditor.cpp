@@ -17,6 +17,7 @@ GranularEditorCommon::GranularEditorCommon (SlicerGranularAudioProcessor& p)
 {
 	audioProcessor.addSampleManagementGutsListener(this);
 	audioProcessor.addMeasuredGrainDescriptionsListener(this);
+	updateGrainBusyDisplayDimensions();
 	
 	auto const fileToRead = audioProcessor.getSampleFilePath();
 	drawThumbnail();
@@ -39,8 +40,17 @@ void GranularEditorCommon::drawThumbnail(){
 	waveformAndPositionComponent.wc.setThumbnailSource(&sampleManagementGuts->getSampleBuffer(),	// do not worry about dangling reference; the thumbnail will internally copy the data as needed to draw waveform
 													   synthBuffer._file_sample_rate, synthBuffer._filename_hash);
 }
+bool GranularEditorCommon::updateGrainBusyDisplayDimensions(){
+	auto const &settings = audioProcessor.viewSynthSharedState()._settings;
+	return grainBusyDisplay.setDimensions(static_cast<size_t>(settings._num_voices), settings._grains_per_voice);
+}
 //============================================= ChangeListener - related =======================================================
 void GranularEditorCommon::displayGrainDescriptions() {
+	if (updateGrainBusyDisplayDimensions()){	// the synth was rebuilt in prepareToPlay
+		if (auto *parent = grainBusyDisplay.getParentComponent()){
+			parent->resized();
+		}
+	}
 	audioProcessor.readGrainDescriptionData(grainDescriptions);
 	waveformAndPositionComponent.wc.removeMarkers(WaveformComponent::MarkerType::CurrentPosition);
 	for (auto gd : grainDescriptions){
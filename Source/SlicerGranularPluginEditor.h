@@ -24,6 +24,7 @@ struct GranularEditorCommon	:	public juce::ChangeListener
 	void changeListenerCallback (juce::ChangeBroadcaster* source) override;
 protected:
 	void drawThumbnail();
+	bool updateGrainBusyDisplayDimensions();	// follows the synth's voice and grain counts; returns whether they changed
 	virtual void displayGrainDescriptions();
 	
 	void handleSampleManagementBroadcast();
@@ -83,10 +84,10 @@ int placeFileCompAndGrainBusyDisplay(juce::Rectangle<int> localBounds, int pad,
 		int const pad = 2;
 		int const grainDisplayHeight = fileCompAndGrainDisplayHeight - pad;
 		
-		grainBusyDisplay.setSizePerGrain((float)grainDisplayHeight / (float)N_VOICES);
+		grainBusyDisplay.setSizePerGrain((float)grainDisplayHeight / (float)grainBusyDisplay.getNumVoices());
 		float const sizePerGrain = grainBusyDisplay.getSizePerGrain();
 		
-		int const grainBusyDisplayWidth = (float)N_GRAINS * sizePerGrain - pad;
+		int const grainBusyDisplayWidth = (float)grainBusyDisplay.getNumGrains() * sizePerGrain - pad;
 		
 		int const grainBusyX = localBounds.getX() + (localBounds.getWidth() - grainBusyDisplayWidth) + pad/2;
 		int const grainBusyY = y + pad/2;
@@ -23,6 +23,25 @@ SlicerGranularAudioProcessor::~SlicerGranularAudioProcessor() = default;
 void SlicerGranularAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
 	_granularSynth->setCurrentPlaybackSampleRate (sampleRate);
+	
+	auto const settings = apvts.state.getChildWithName("Settings");	// absent properties fall back to the defaults in VoicesXGrains.h
+	_granularSynth->setVoiceAndGrainCounts(settings.getProperty("numVoices", N_VOICES),
+										   settings.getProperty("grainsPerVoice", static_cast<int>(N_GRAINS)));
+	{	// "renderWorkers": real-time threads that render alongside the audio thread; 0 (the default) renders everything on it.
+		// They take whole voices or, with "parallelGrains" set, the grains of any voice with at least "minParallelGrains" sounding
+		int const renderWorkers = settings.getProperty("renderWorkers", 0);
+		bool const parallelGrains = settings.getProperty("parallelGrains", false);
+		int const minParallelGrains = settings.getProperty("minParallelGrains", static_cast<int>(nvs::gran::GrainPool::defaultMinParallelGrains));
+		using VoiceRendering = nvs::gran::GranularSynthesizer::VoiceRendering;
+		auto const mode = (renderWorkers <= 0) ? VoiceRendering::sequential
+							: (parallelGrains ? VoiceRendering::parallelGrains : VoiceRendering::parallel);
+		_granularSynth->setVoiceRendering(mode, renderWorkers, samplesPerBlock, static_cast<size_t>(std::max(minParallelGrains, 1)));
+	}
+	{	// "interpolation" while live, "offlineInterpolation" for bounces: "linear", "hermite" or "sinc"
+		juce::String const name = settings.getProperty(isNonRealtime() ? "offlineInterpolation" : "interpolation", "hermite");
+		using Quality = nvs::gran::interp::Quality;
+		_granularSynth->setInterpolation(name == "linear" ? Quality::linear : (name == "sinc" ? Quality::sinc : Quality::hermite));
+	}
 	for (int i = 0; i < _granularSynth->getNumVoices(); i++)
 	{
 		if (auto voice = dynamic_cast<nvs::gran::GranularVoice *>(_granularSynth->getVoice(i)))
@@ -162,7 +181,11 @@ void SlicerGranularAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     const std::vector<nvs::gran::GrainDescription> descriptions = _granularSynth->getGrainDescriptions();
 	writeGrainDescriptionData(descriptions);
 	
-	loggingGuts.logIfNaNOrInf(buffer);
+	if (auto const numNonFinite = _granularSynth->getNumNonFiniteBlocks(); numNonFinite != loggedNonFiniteBlocks){
+		loggedNonFiniteBlocks = numNonFinite;
+		logRateLimited("processBlock: zeroed a block with NaN or Inf from voice " + juce::String(_granularSynth->getLastNonFiniteVoice())
+					   + " (" + juce::String(static_cast<int>(numNonFinite)) + " so far)", 1000);
+	}
 }
 
 void SlicerGranularAudioProcessor::writeGrainDescriptionData(const std::vector<nvs::gran::GrainDescription> &newData){
@@ -95,6 +95,9 @@ public:
 	nvs::service::PresetManager &getPresetManager() { return presetManager; }
 	
 	nvs::gran::GranularSynthSharedState const &viewSynthSharedState() const;
+	std::uint32_t getNumNonFiniteBlocks() const {	// voice blocks the synth zeroed for NaN/Inf; for display
+		return _granularSynth ? _granularSynth->getNumNonFiniteBlocks() : 0;
+	}
 protected:
 	SlicerGranularAudioProcessor();
 	void initialize() {
@@ -115,6 +118,7 @@ protected:
 	nvs::util::LoggingGuts loggingGuts;
 
 	juce::int64 lastLogTimeMs = 0;
+	std::uint32_t loggedNonFiniteBlocks = 0;
 	void logRateLimited(const juce::String& message, int cooldownMs)
 	{
 		auto now = juce::Time::getMillisecondCounter();
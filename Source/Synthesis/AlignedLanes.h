@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    AlignedLanes.h
+    Created: 17 Oct 2026 6:02:19pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace nvs::gran {
+/**
+ Contiguous, cache-line aligned storage for one value per grain lane (or per source sample).
+ */
+template <typename T>
+class AlignedLanes {
+public:
+	static constexpr std::size_t alignment {64};
+	
+	explicit AlignedLanes(std::size_t size)
+	:	_data(static_cast<T*>(::operator new[](size * sizeof(T), std::align_val_t{alignment})))
+	,	_size(size)
+	{
+		std::fill_n(_data.get(), _size, T{});
+	}
+	T &operator[](std::size_t i) { return _data[i]; }
+	T const &operator[](std::size_t i) const { return _data[i]; }
+	T *data() { return _data.get(); }
+	T const *data() const { return _data.get(); }
+	std::size_t size() const { return _size; }
+private:
+	struct Deleter {
+		void operator()(T *p) const { ::operator delete[](p, std::align_val_t{alignment}); }
+	};
+	std::unique_ptr<T[], Deleter> _data;
+	std::size_t _size;
+};
+}	// namespace nvs::gran
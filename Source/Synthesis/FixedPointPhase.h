@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    FixedPointPhase.h
+    Created: 16 Oct 2026 8:41:17pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <cassert>
+
+namespace nvs::gran {
+/**
+ A source read position as a signed whole sample plus a 32-bit fraction.
+ Advancing by a constant step is exact integer arithmetic, so a grain's read position does not drift the way an accumulated
+ float would, and the fraction handed to interpolation keeps full float resolution however far into the file the grain reads.
+ */
+struct FixedPointPhase {
+	static constexpr double fracScale {4294967296.0};	// 2^32
+
+	std::int32_t whole {0};
+	std::uint32_t frac {0};	// in units of 2^-32 samples
+
+	static FixedPointPhase fromDouble(double const x){
+		double const w = std::floor(x);
+		return {
+			static_cast<std::int32_t>(w),
+			static_cast<std::uint32_t>(std::min((x - w) * fracScale, fracScale - 1.0))
+		};
+	}
+	double toDouble() const {
+		return static_cast<double>(whole) + static_cast<double>(frac) / fracScale;
+	}
+	float fraction() const {	// in [0, 1); the top 24 bits convert exactly
+		return static_cast<float>(frac >> 8) * 0x1p-24f;
+	}
+	void advance(FixedPointPhase const step){
+		std::uint32_t const f = frac + step.frac;
+		whole += step.whole + static_cast<std::int32_t>(f < frac);	// carry
+		frac = f;
+	}
+	std::int64_t raw() const {	// in units of 2^-32 samples
+		return static_cast<std::int64_t>(whole) * (std::int64_t{1} << 32) + static_cast<std::int64_t>(frac);
+	}
+	static FixedPointPhase fromRaw(std::int64_t const raw){
+		return {static_cast<std::int32_t>(raw >> 32), static_cast<std::uint32_t>(raw & 0xffffffff)};
+	}
+	void wrap(FixedPointPhase const period){	// into [0, period), which need not be a whole number of samples
+		std::int64_t const p = period.raw();
+		assert (p > 0);
+		std::int64_t r = raw();
+		if ((r < 0) || (r >= p)){
+			r %= p;
+			*this = fromRaw((r < 0) ? r + p : r);
+		}
+	}
+};
+}	// namespace nvs::gran
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    GrainAllocator.h
+    Created: 16 Oct 2026 4:52:03pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <cstdint>
+#include "GrainSlots.h"
+
+namespace nvs::gran {
+
+enum class GrainAllocation {
+	roundRobin,		// the next free grain after the one last started
+	randomFree,		// uniformly among the free grains
+	oldestFirst		// the free grain that was started least recently
+};
+
+/**
+ Chooses which free grain catches a trigger. It is consulted only when a trigger fires, so no per-sample work is spent
+ on randomizing grain order.
+ */
+class GrainAllocator {
+public:
+	explicit GrainAllocator(std::size_t numGrains)
+	:	_last_started(numGrains, 0)
+	{}
+	void reset(){
+		_cursor = 0;
+		_starts = 0;
+		std::fill(_last_started.begin(), _last_started.end(), 0);
+	}
+	template <typename URBG>
+	std::optional<std::size_t> choose(GrainAllocation const policy, GrainSlots const &slots, URBG &rng) const {
+		auto const free = slots.free();
+		if (free.empty()){
+			return std::nullopt;
+		}
+		switch (policy){
+			case GrainAllocation::roundRobin: {
+				auto const n = _last_started.size();
+				for (std::size_t i = 0; i < n; ++i){
+					std::size_t const idx = (_cursor + i) % n;
+					if (!slots.isActive(idx)){
+						return idx;
+					}
+				}
+				return std::nullopt;	// unreachable while free is non-empty
+			}
+			case GrainAllocation::randomFree: {
+				return free[static_cast<std::size_t>(rng() % free.size())];
+			}
+			case GrainAllocation::oldestFirst: {
+				std::size_t oldest = free[0];
+				for (auto const idx : free){
+					if (_last_started[idx] < _last_started[oldest]){
+						oldest = idx;
+					}
+				}
+				return oldest;
+			}
+		}
+		return std::nullopt;
+	}
+	void noteStarted(std::size_t idx){
+		_last_started[idx] = ++_starts;
+		_cursor = (idx + 1) % _last_started.size();
+	}
+private:
+	std::vector<std::uint64_t> _last_started;	// start count at which each grain was last started; 0 = never
+	std::uint64_t _starts {0};
+	std::size_t _cursor {0};
+};
+}	// namespace nvs::gran
@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+    GrainBank.cpp
+    Created: 16 Oct 2026 10:48:20am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "GrainBank.h"
+#include "GrainWindow.h"
+#include "Waveshaper.h"
+#include "../../nvs_libraries/nvs_libraries/include/nvs_gen.h"
+#include "Interpolation.h"
+#include <limits>
+#include <numbers>
+
+namespace nvs::gran {
+
+namespace {
+std::size_t roundUpToLaneGroups(std::size_t n){
+	return ((n + GrainBank<double>::laneWidth - 1) / GrainBank<double>::laneWidth) * GrainBank<double>::laneWidth;
+}
+}	// end anonymous namespace
+
+template <typename Real>
+GrainBank<Real>::GrainBank(std::size_t numGrains, GrainWindowTable const &windowTable)
+:	_num_grains(numGrains)
+,	_capacity(roundUpToLaneGroups(numGrains))
+,	_window_table(windowTable)
+,	_accum(_capacity)
+,	_window_phase(_capacity)
+,	_window(_capacity)
+,	_cursor(_capacity)
+,	_owner(_capacity)
+,	_source(_capacity)
+,	_level(_capacity)
+,	_read_rate(_capacity)
+,	_window_length(_capacity)
+,	_skew(_capacity)
+,	_window_key(_capacity)
+,	_amplitude(_capacity)
+,	_pan(_capacity)
+,	_gain_L(_capacity)
+,	_gain_R(_capacity)
+,	_drive(_capacity)
+,	_shaper_gain(_capacity)
+{
+	for (std::size_t k = 0; k < _capacity; ++k){
+		// every lane, including the padding lanes beyond _num_grains, starts out as a finished, silent grain
+		_accum[k] = 1.0;
+		_window_length[k] = 1.0;
+		_window_phase[k] = 1.0;
+		_skew[k] = 0.5f;
+		_drive[k] = 1.f;
+		_shaper_gain[k] = 1.f;
+		if constexpr (std::is_same_v<Real, double>){
+			_cursor.period[k] = 1.0;
+		} else {
+			_cursor.period[k] = FixedPointPhase::fromDouble(1.0);
+		}
+	}
+}
+
+template <typename Real>
+void GrainBank<Real>::start(std::size_t lane, GrainSpawn const &spawn, LevelView const &source, int const owner){
+	assert (lane < _num_grains);
+	assert (spawn.window_length > 0.0);
+	assert (spawn.level == source.level);
+	_accum[lane] = 0.0;
+	_window_phase[lane] = 0.0;
+	_window[lane] = 0.f;
+	
+	_owner[lane] = owner;
+	_source[lane] = source.source;
+	_level[lane] = source.level;
+	_read_rate[lane] = spawn.read_rate;
+	_window_length[lane] = spawn.window_length;
+	if constexpr (std::is_same_v<Real, double>){
+		_cursor.origin[lane] = spawn.index_origin;
+		_cursor.rate[lane] = spawn.index_rate;
+		_cursor.index[lane] = spawn.index_origin;
+		_cursor.period[lane] = source.period;
+	} else {
+		_cursor.phase[lane] = FixedPointPhase::fromDouble(spawn.index_origin);
+		_cursor.step[lane] = FixedPointPhase::fromDouble(spawn.index_rate * spawn.read_rate);	// source samples per output sample
+		_cursor.period[lane] = FixedPointPhase::fromDouble(source.period);
+	}
+	_skew[lane] = spawn.skew;
+	_window_key[lane] = _window_table.makeKey(spawn.plateau);
+	_amplitude[lane] = spawn.amplitude;
+	_pan[lane] = spawn.pan;
+	_gain_L[lane] = spawn.gain_L;
+	_gain_R[lane] = spawn.gain_R;
+	_drive[lane] = spawn.drive;
+	_shaper_gain[lane] = spawn.shaper_gain;
+}
+template <typename Real>
+bool GrainBank<Real>::isIdle(std::size_t lane) const {
+	return (_window_phase[lane] >= 1.0) && (_window[lane] == 0.f);
+}
+template <typename Real>
+bool GrainBank<Real>::groupIsIdleFor(std::size_t firstLane, int const owner) const {
+	for (std::size_t k = firstLane; k < firstLane + laneWidth; ++k){
+		if ((_owner[k] == owner) && !isIdle(k)){
+			return false;
+		}
+	}
+	return true;
+}
+template <typename Real>
+void GrainBank<Real>::setIdle(){
+	for (std::size_t k = 0; k < _capacity; ++k){
+		setIdle(k);
+	}
+}
+template <typename Real>
+void GrainBank<Real>::setIdle(std::size_t lane){
+	_window_phase[lane] = 1.0;
+	_window[lane] = 0.f;
+	_accum[lane] = _window_length[lane];
+}
+template <typename Real>
+void GrainBank<Real>::retarget(std::size_t lane, SourceLevels const &source){
+	int const level = _level[lane];
+	double period {0.0};
+	if constexpr (std::is_same_v<Real, double>){
+		period = _cursor.period[lane];
+	} else {
+		period = _cursor.period[lane].toDouble();
+	}
+	bool const sameLevel = (level < source.getNumLevels()) && (source.periodOf(level) == period);
+	auto const latched = source.latch(sameLevel ? level : 0);
+	_source[lane] = latched.source;
+	_level[lane] = latched.level;
+	if (sameLevel){
+		return;
+	}
+	// into level 0 samples, which every source has
+	if constexpr (std::is_same_v<Real, double>){
+		double const scale = std::ldexp(1.0, level);
+		_cursor.origin[lane] *= scale;
+		_cursor.rate[lane] *= scale;
+		_cursor.index[lane] *= scale;
+		_cursor.period[lane] = latched.period;
+	} else {
+		// both first wrapped into the level's period, which changes no read, since every read is wrapped there: so once scaled
+		// each is less than level 0's period, which a FixedPointPhase holds, and the raw product cannot overflow however fast
+		// the grain or however long the source
+		auto &phase = _cursor.phase[lane];
+		auto &step = _cursor.step[lane];
+		phase.wrap(_cursor.period[lane]);
+		step.wrap(_cursor.period[lane]);
+		std::int64_t const scale = std::int64_t{1} << level;
+		assert (_cursor.period[lane].raw() <= std::numeric_limits<std::int64_t>::max() / scale);
+		phase = FixedPointPhase::fromRaw(phase.raw() * scale);
+		step = FixedPointPhase::fromRaw(step.raw() * scale);
+		_cursor.period[lane] = FixedPointPhase::fromDouble(latched.period);
+	}
+}
+
+template <typename Real>
+void GrainBank<Real>::process(float *const outL, float *const outR, int const numSamples, int const owner){
+	process(outL, outR, numSamples, owner, 0, _capacity, _scratch);
+}
+template <typename Real>
+void GrainBank<Real>::process(float *const outL, float *const outR, int const numSamples,
+							  int const owner, std::size_t const firstLane, std::size_t const numLanes, RowScratch &scratch){
+	assert((firstLane % laneWidth == 0) && (firstLane + numLanes <= _capacity));
+	for (std::size_t group = firstLane; group < firstLane + numLanes; group += laneWidth){
+		if (groupIsIdleFor(group, owner)){
+			continue;
+		}
+		for (int start = 0; start < numSamples; start += maxRows){
+			int const n = std::min(maxRows, numSamples - start);
+			renderRows(group, n, owner, scratch);
+			shaper::processRows(scratch.L.data(), static_cast<std::size_t>(n), &_drive[group], &_shaper_gain[group]);
+			shaper::processRows(scratch.R.data(), static_cast<std::size_t>(n), &_drive[group], &_shaper_gain[group]);
+			for (int i = 0; i < n; ++i){
+				float sum_L {0.f};
+				float sum_R {0.f};
+				for (std::size_t j = 0; j < laneWidth; ++j){
+					sum_L += scratch.L[static_cast<std::size_t>(i) * laneWidth + j];
+					sum_R += scratch.R[static_cast<std::size_t>(i) * laneWidth + j];
+				}
+				outL[start + i] += sum_L;
+				outR[start + i] += sum_R;
+			}
+		}
+	}
+}
+template <typename Real>
+void GrainBank<Real>::renderRows(std::size_t const group, int const numRows, int const owner, RowScratch &scratch){
+	switch (_interpolation){
+		case interp::Quality::linear:
+			renderRows<interp::Quality::linear>(group, numRows, owner, scratch);
+			break;
+		case interp::Quality::hermite:
+			renderRows<interp::Quality::hermite>(group, numRows, owner, scratch);
+			break;
+		case interp::Quality::sinc:
+			renderRows<interp::Quality::sinc>(group, numRows, owner, scratch);
+			break;
+	}
+}
+template <typename Real>
+template <interp::Quality Q>
+void GrainBank<Real>::renderRows(std::size_t const group, int const numRows, int const owner, RowScratch &scratch){
+	// the sounding lanes of a group usually share a source level (one note, one transposition), and then read it in one gather;
+	// the group's other lanes read sample 0 of that level instead of their own, since their samples are discarded anyway
+	SourceView shared {};
+	bool uniform {true};
+	std::array<bool, laneWidth> sounding;
+	for (std::size_t j = 0; j < laneWidth; ++j){
+		std::size_t const k = group + j;
+		sounding[j] = (_owner[k] == owner) && !isIdle(k);
+		if (sounding[j]){
+			uniform = uniform && (!shared.frames || (_source[k].frames == shared.frames));
+			shared = shared.frames ? shared : _source[k];
+		}
+	}
+	bool const reads = (shared.frames != nullptr);	// else every grain of the group ended in an earlier pass of this block
+	bool const stereo = (shared.numChannels == 2);
+	// a mono source is read once, into the left samples, and panned from there into both rows
+	alignas(AlignedLanes<float>::alignment) std::array<float, laneWidth> samples_L {};
+	alignas(AlignedLanes<float>::alignment) std::array<float, laneWidth> samples_R {};
+	float const *const right = stereo ? samples_R.data() : samples_L.data();
+	auto const read = [&](auto const &...position){	// (indices) or (wholes, fracs) of every lane, from the shared level
+		if (stereo){
+			interp::gatherStereo<Q>(shared.frames, shared.length, position.data()..., samples_L.data(), samples_R.data(), laneWidth);
+		} else {
+			interp::gather<Q>(shared.frames, shared.length, position.data()..., samples_L.data(), laneWidth);
+		}
+	};
+	auto const readLane = [&](std::size_t const j, auto const *const ...position){	// one sounding lane, from its own level
+		auto const &source = _source[group + j];
+		if (!sounding[j]){
+			samples_L[j] = samples_R[j] = 0.f;
+		} else if (stereo){
+			interp::gatherStereo<Q>(source.frames, source.length, position..., &samples_L[j], &samples_R[j], 1);
+		} else {
+			interp::gather<Q>(source.frames, source.length, position..., &samples_L[j], 1);
+		}
+	};
+	
+	for (int i = 0; i < numRows; ++i){
+		if constexpr (std::is_same_v<Real, double>){
+			alignas(AlignedLanes<double>::alignment) std::array<double, laneWidth> indices;
+			for (std::size_t j = 0; j < laneWidth; ++j){
+				std::size_t const k = group + j;
+				_cursor.index[k] = _cursor.origin[k] + _cursor.rate[k] * _accum[k];
+				indices[j] = sounding[j] ? wrapToPeriod(_cursor.index[k], _cursor.period[k]) : 0.0;
+			}
+			if (reads && uniform){
+				read(indices);
+			} else if (reads){
+				for (std::size_t j = 0; j < laneWidth; ++j){
+					readLane(j, &indices[j]);
+				}
+			}
+		} else {
+			alignas(AlignedLanes<std::int32_t>::alignment) std::array<std::int32_t, laneWidth> wholes;
+			alignas(AlignedLanes<float>::alignment) std::array<float, laneWidth> fracs;
+			for (std::size_t j = 0; j < laneWidth; ++j){
+				std::size_t const k = group + j;
+				auto &phase = _cursor.phase[k];
+				phase.wrap(_cursor.period[k]);
+				wholes[j] = sounding[j] ? phase.whole : 0;	// else its whole may lie beyond the shared level
+				fracs[j] = sounding[j] ? phase.fraction() : 0.f;
+			}
+			if (reads && uniform){
+				read(wholes, fracs);
+			} else if (reads){
+				for (std::size_t j = 0; j < laneWidth; ++j){
+					readLane(j, &wholes[j], &fracs[j]);
+				}
+			}
+		}
+		
+		float *const row_L = &scratch.L[static_cast<std::size_t>(i) * laneWidth];
+		float *const row_R = &scratch.R[static_cast<std::size_t>(i) * laneWidth];
+		for (std::size_t j = 0; j < laneWidth; ++j){
+			std::size_t const k = group + j;
+			if (_owner[k] != owner){
+				row_L[j] = 0.f;	// another voice's grain; it advances when that voice renders
+				row_R[j] = 0.f;
+				continue;
+			}
+			double const phase = memoryless::clamp(_accum[k] / _window_length[k], 0.0, 1.0);
+			float const win = _window_table.window(_window_key[k], phase, _skew[k]);
+			float const gain = win * _amplitude[k];
+			row_L[j] = (gain * samples_L[j]) * _gain_L[k];
+			row_R[j] = (gain * right[j]) * _gain_R[k];
+			
+			_window_phase[k] = phase;
+			_window[k] = win;
+			_accum[k] += _read_rate[k];
+			if constexpr (std::is_same_v<Real, float>){
+				_cursor.phase[k].advance(_cursor.step[k]);
+			}
+		}
+	}
+}
+
+template <typename Real>
+void GrainBank<Real>::describe(std::size_t lane, GrainDescription &gd, std::size_t waveLength) const {
+	assert (lane < _num_grains);
+	double sampleIndex {0.0};
+	if constexpr (std::is_same_v<Real, double>){
+		sampleIndex = _cursor.index[lane];
+	} else {
+		sampleIndex = _cursor.phase[lane].toDouble();
+	}
+	sampleIndex = std::ldexp(sampleIndex, _level[lane]);	// in level 0 samples
+	gd.position = waveLength ? nvs::gen::wrap01(sampleIndex / static_cast<double>(waveLength)) : 0.0;
+	gd.sample_playback_rate = _read_rate[lane];
+	gd.window = _window[lane];
+	gd.pan = _pan[lane] / (std::numbers::pi * 0.5f);
+	gd.busy = _window[lane] > 0.f;
+}
+
+template class GrainBank<float>;
+template class GrainBank<double>;
+}	// namespace nvs::gran
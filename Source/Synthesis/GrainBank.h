@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    GrainBank.h
+    Created: 16 Oct 2026 10:48:20am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <type_traits>
+#include "AlignedLanes.h"
+#include "GrainSpawn.h"
+#include "GrainDescription.h"
+#include "GrainWindow.h"
+#include "FixedPointPhase.h"
+#include "Interpolation.h"
+#include "SourcePyramid.h"
+
+namespace nvs::gran {
+/**
+ maxRows rows of laneWidth: a lane group's panned output, shaped together before it is summed. The same for both precisions.
+ */
+struct GrainRowScratch {
+	static constexpr std::size_t laneWidth {8};
+	static constexpr int maxRows {512};
+	GrainRowScratch()	:	L(maxRows * laneWidth), R(maxRows * laneWidth)	{}
+	AlignedLanes<float> L;
+	AlignedLanes<float> R;
+};
+
+/**
+ How a lane of a GrainBank<Real> tracks where it reads in the source.
+ */
+template <typename Real>
+struct SourceCursorLanes;
+
+template <>
+struct SourceCursorLanes<double> {	// recomputed every sample from the accumulator: origin + rate * accum
+	explicit SourceCursorLanes(std::size_t n)	:	origin(n), rate(n), index(n), period(n)	{}
+	AlignedLanes<double> origin;
+	AlignedLanes<double> rate;
+	AlignedLanes<double> index;
+	AlignedLanes<double> period;	// of the latched level, see LevelView
+};
+template <>
+struct SourceCursorLanes<float> {	// a fixed-point phase advanced by a constant step, so the float accumulators never address the source
+	explicit SourceCursorLanes(std::size_t n)	:	phase(n), step(n), period(n)	{}
+	AlignedLanes<FixedPointPhase> phase;
+	AlignedLanes<FixedPointPhase> step;
+	AlignedLanes<FixedPointPhase> period;	// exact: a source length over a power of two
+};
+
+/**
+ Structure-of-arrays grain renderer.
+ Where a Grain is one object carrying its own latches and random generators, the bank only keeps the per-sample state of every
+ grain in parallel arrays, so that a group of laneWidth grains advances in lockstep (AVX2: 8 floats, NEON: 2x4).
+ Triggering and parameter latching still happen in Grain (see Grain::spawn()); GrainPlayer is the scalar reference renderer.
+ Lanes are tagged with an owner (the voice in a GrainPool), and process() only advances the lanes of one owner.
+ 
+ Real is the precision of the source cursor. GrainBank<double> is the reference. GrainBank<float> reads the source through a
+ FixedPointPhase instead, so its reads run on full 8-wide float vectors, for sources up to maxSourceLength long (see GrainPool
+ for the fallback). The window accumulator is double in both, as in GrainPlayer, so that every engine ends a grain, and frees
+ its lane for the next onset, on the same sample.
+ */
+template <typename Real>
+class GrainBank {
+public:
+	static_assert(std::is_same_v<Real, float> || std::is_same_v<Real, double>);
+	static constexpr std::size_t laneWidth {GrainRowScratch::laneWidth};
+	static constexpr std::size_t maxSourceLength {std::size_t{1} << 24};	// for single precision
+	static constexpr int maxRows {GrainRowScratch::maxRows};	// samples per group shaped in one pass
+	
+	using RowScratch = GrainRowScratch;
+	
+	GrainBank(std::size_t numGrains, GrainWindowTable const &windowTable);
+	
+	std::size_t getNumGrains() const { return _num_grains; }
+	void start(std::size_t lane, GrainSpawn const &spawn, LevelView const &source, int owner = 0);	// spawn is in source's samples
+	bool isIdle(std::size_t lane) const;
+	void setIdle();
+	void setIdle(std::size_t lane);
+	void retarget(std::size_t lane, SourceLevels const &source);	// see GrainPool::retarget()
+	
+	void process(float *outL, float *outR, int numSamples, int owner = 0);	// adds into outL/outR
+	/**
+	 As above, over lanes [firstLane, firstLane + numLanes) only (whole lane groups) and with the caller's scratch, so that
+	 disjoint lane ranges can be processed on different threads.
+	 */
+	void process(float *outL, float *outR, int numSamples, int owner, std::size_t firstLane, std::size_t numLanes, RowScratch &scratch);
+	
+	void describe(std::size_t lane, GrainDescription &gd, std::size_t waveLength) const;
+	void setInterpolation(interp::Quality quality) { _interpolation = quality; }	// resolved per lane group pass, not per read
+private:
+	std::size_t _num_grains;
+	std::size_t _capacity;	// _num_grains rounded up to a whole number of lane groups
+	GrainWindowTable const &_window_table;
+	
+	bool groupIsIdleFor(std::size_t firstLane, int owner) const;
+	interp::Quality _interpolation {interp::Quality::hermite};
+	
+	void renderRows(std::size_t group, int numRows, int owner, RowScratch &scratch);	// unshaped
+	template <interp::Quality Q>
+	void renderRows(std::size_t group, int numRows, int owner, RowScratch &scratch);
+	
+	// per-sample state
+	AlignedLanes<double> _accum;
+	AlignedLanes<double> _window_phase;
+	AlignedLanes<float> _window;
+	SourceCursorLanes<Real> _cursor;
+	
+	// per-grain constants, written by start()
+	AlignedLanes<int> _owner;
+	AlignedLanes<SourceView> _source;	// the latched level's frames
+	AlignedLanes<int> _level;
+	AlignedLanes<double> _read_rate;
+	AlignedLanes<double> _window_length;
+	AlignedLanes<float> _skew;
+	AlignedLanes<GrainWindowTable::Key> _window_key;
+	AlignedLanes<float> _amplitude;
+	AlignedLanes<float> _pan;
+	AlignedLanes<float> _gain_L;
+	AlignedLanes<float> _gain_R;
+	AlignedLanes<float> _drive;
+	AlignedLanes<float> _shaper_gain;
+	
+	RowScratch _scratch;	// for the single-threaded process()
+};
+}	// namespace nvs::gran
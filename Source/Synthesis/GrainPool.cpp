@@ -0,0 +1,381 @@
+/*
+  ==============================================================================
+
+    GrainPool.cpp
+    Created: 16 Oct 2026 7:26:51pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "GrainPool.h"
+#include "Waveshaper.h"
+#include "../../nvs_libraries/nvs_libraries/include/nvs_gen.h"
+#include <numbers>
+
+namespace nvs::gran {
+
+void GrainPlayer::start(GrainSpawn const &spawn, LevelView const &source, GrainWindowTable const &windowTable){
+	assert (spawn.window_length > 0.0);
+	assert (spawn.level == source.level);
+	_spawn = spawn;
+	_source = source;
+	_window_key = windowTable.makeKey(spawn.plateau);
+	_gain_L = spawn.gain_L;
+	_gain_R = spawn.gain_R;
+	_starting = true;
+	_accum = 0.0;
+	_window_phase = 0.0;
+	_window = 0.f;
+	_sample_index = spawn.index_origin;
+}
+bool GrainPlayer::isIdle() const {
+	// a freshly started grain has a window of 0 on its first sample, so the window phase decides.
+	return !_starting && (_window_phase >= 1.0) && (_window == 0.f);
+}
+void GrainPlayer::setIdle(){
+	_starting = false;
+	_window_phase = 1.0;
+	_window = 0.f;
+}
+void GrainPlayer::retarget(SourceLevels const &source){
+	int const level = _source.level;
+	if ((level < source.getNumLevels()) && (source.periodOf(level) == _source.period)){
+		_source = source.latch(level);
+		return;
+	}
+	double const scale = std::ldexp(1.0, level);	// into level 0 samples, which every source has
+	_spawn.index_origin *= scale;
+	_spawn.index_rate *= scale;
+	_spawn.level = 0;
+	_sample_index *= scale;
+	_source = source.latch(0);
+}
+namespace {
+template <interp::Quality Q>
+float readSource(float const *wave, double index, std::size_t waveLength);
+template <>
+float readSource<interp::Quality::linear>(float const *const wave, double const index, std::size_t const waveLength){
+	return interp::linearRead(wave, waveLength, index);
+}
+template <>
+float readSource<interp::Quality::hermite>(float const *const wave, double const index, std::size_t const waveLength){
+	return interp::hermiteRead(wave, waveLength, index);
+}
+template <>
+float readSource<interp::Quality::sinc>(float const *const wave, double const index, std::size_t const waveLength){
+	return interp::sincRead(wave, waveLength, index);
+}
+template <interp::Quality Q>
+void readFrame(SourceView const &source, double const index, float &left, float &right){	// index already wrapped
+	if (source.numChannels == 1){
+		left = right = readSource<Q>(source.frames, index, source.length);
+	} else {
+		interp::gatherStereo<Q>(source.frames, source.length, &index, &left, &right, 1);
+	}
+}
+}	// end anonymous namespace
+
+void GrainPlayer::processBlock(GrainWindowTable const &windowTable, float *const outL, float *const outR,
+							   float *const scratchL, float *const scratchR, int const numSamples, interp::Quality const quality)
+{
+	assert((_source.source.numChannels > 0) && (_source.source.numChannels <= SourceBuffer::maxChannels));
+	assert(_source.period > 0.0);
+	int n = 0;
+	switch (quality){
+		case interp::Quality::linear:
+			n = render<interp::Quality::linear>(windowTable, scratchL, scratchR, numSamples);
+			break;
+		case interp::Quality::hermite:
+			n = render<interp::Quality::hermite>(windowTable, scratchL, scratchR, numSamples);
+			break;
+		case interp::Quality::sinc:
+			n = render<interp::Quality::sinc>(windowTable, scratchL, scratchR, numSamples);
+			break;
+	}
+	shaper::process(scratchL, static_cast<std::size_t>(n), _spawn.drive, _spawn.shaper_gain);
+	shaper::process(scratchR, static_cast<std::size_t>(n), _spawn.drive, _spawn.shaper_gain);
+	for (int i = 0; i < n; ++i){	// non-finite samples are caught once per voice block, by PolyGrain
+		outL[i] += scratchL[i];
+		outR[i] += scratchR[i];
+	}
+}
+template <interp::Quality Q>
+int GrainPlayer::render(GrainWindowTable const &windowTable, float *const scratchL, float *const scratchR, int const numSamples)
+{
+	int n = 0;
+	while ((n < numSamples) && !isIdle()){	// once finished, it stays silent until started again
+		_accum = _starting ? 0.0 : _accum + _spawn.read_rate;
+		_starting = false;
+		_window_phase = memoryless::clamp(_accum / _spawn.window_length, 0.0, 1.0);
+		_window = windowTable.window(_window_key, _window_phase, _spawn.skew);
+		_sample_index = _spawn.index_origin + _spawn.index_rate * _accum;
+		
+		float left, right;
+		readFrame<Q>(_source.source, wrapToPeriod(_sample_index, _source.period), left, right);	// a mono source reads the same sample into both
+		float const gain = _window * _spawn.amplitude;
+		scratchL[n] = (gain * left) * _gain_L;
+		scratchR[n] = (gain * right) * _gain_R;
+		++n;
+	}
+	return n;
+}
+void GrainPlayer::describe(GrainDescription &gd, std::size_t waveLength) const {
+	double const sampleIndex = std::ldexp(_sample_index, _source.level);	// in level 0 samples
+	gd.position = waveLength ? nvs::gen::wrap01(sampleIndex / static_cast<double>(waveLength)) : 0.0;
+	gd.sample_playback_rate = _spawn.read_rate;
+	gd.window = _window;
+	gd.pan = _spawn.pan / (std::numbers::pi * 0.5f);
+	gd.busy = _window > 0.f;
+}
+
+//=====================================================================================
+GrainPool::Partition::Partition(std::size_t const firstSlot, std::size_t const numSlots)
+:	first(firstSlot)
+,	size(numSlots)
+,	slots(numSlots)
+,	allocator(numSlots)
+,	scratch_L(maxRenderBlock, 0.f)
+,	scratch_R(maxRenderBlock, 0.f)
+{}
+
+GrainPool::ThreadScratch::ThreadScratch()
+:	out_L(maxRenderBlock, 0.f)
+,	out_R(maxRenderBlock, 0.f)
+,	scratch_L(maxRenderBlock, 0.f)
+,	scratch_R(maxRenderBlock, 0.f)
+{}
+
+GrainPool::GrainPool(std::size_t capacity, GrainWindowTable const &windowTable)
+:	_window_table(windowTable)
+{
+	allocate(capacity, 1);
+}
+void GrainPool::setCapacity(std::size_t const capacity){
+	allocate(capacity, getNumPartitions());
+}
+void GrainPool::setPartitions(std::size_t const numPartitions){
+	allocate(_requested_capacity, numPartitions);
+}
+void GrainPool::setInterpolation(interp::Quality const quality){
+	_interpolation = quality;
+	_bank->setInterpolation(quality);
+	_bank_single->setInterpolation(quality);
+}
+void GrainPool::setGrainWorkers(RenderWorkerPool *const workers, std::size_t const minGrains, int const minSpan){
+	_grain_workers = workers;
+	_min_parallel_grains = std::max<std::size_t>(minGrains, 1);
+	_min_parallel_span = std::max(minSpan, 1);
+	_thread_scratch.clear();
+	if (workers != nullptr){
+		_thread_scratch.resize(static_cast<std::size_t>(workers->getNumThreads()));
+		_chunks.setNumThreads(workers->getNumThreads());
+	}
+}
+void GrainPool::allocate(std::size_t const capacity, std::size_t numPartitions){
+	numPartitions = std::max<std::size_t>(numPartitions, 1);
+	_requested_capacity = capacity;
+	// partitions beyond the first start on a lane-group boundary, so no bank lane group is shared between two of them
+	std::size_t perPartition = capacity;
+	if (numPartitions > 1){
+		std::size_t const laneWidth = GrainRowScratch::laneWidth;
+		perPartition = (capacity + numPartitions - 1) / numPartitions;
+		perPartition = ((perPartition + laneWidth - 1) / laneWidth) * laneWidth;
+	}
+	std::size_t const total = perPartition * numPartitions;
+	
+	_partitions.clear();
+	_partitions.reserve(numPartitions);
+	for (std::size_t p = 0; p < numPartitions; ++p){
+		_partitions.emplace_back(p * perPartition, perPartition);
+	}
+	_owner.assign(total, -1);
+	_spawner.assign(total, -1);
+	_players.assign(total, GrainPlayer{});
+	_single_precision.assign(total, false);
+	_bank = std::make_unique<GrainBank<double>>(total, _window_table);
+	_bank_single = std::make_unique<GrainBank<float>>(total, _window_table);
+	setInterpolation(_interpolation);
+}
+GrainPool::Partition &GrainPool::partitionFor(int const owner){
+	assert (owner >= 0);
+	return _partitions[static_cast<std::size_t>(owner) % _partitions.size()];
+}
+GrainPool::Partition const &GrainPool::partitionFor(int const owner) const {
+	assert (owner >= 0);
+	return _partitions[static_cast<std::size_t>(owner) % _partitions.size()];
+}
+
+bool GrainPool::isIdle(std::size_t slot) const {
+	if (_engine == GrainEngine::structureOfArrays){
+		return _single_precision[slot] ? _bank_single->isIdle(slot) : _bank->isIdle(slot);
+	}
+	return _players[slot].isIdle();
+}
+void GrainPool::start(std::size_t slot, GrainSpawn spawn, SourceLevels const &source){
+	[[maybe_unused]] auto const &partition = partitionFor(_owner[slot]);
+	assert (partition.slots.isActive(slot - partition.first));
+	auto const level = source.latch(source.levelFor(std::abs(spawn.read_rate * spawn.index_rate)));
+	spawn.level = level.level;
+	double const levelScale = std::ldexp(1.0, -spawn.level);
+	spawn.index_origin *= levelScale;
+	spawn.index_rate *= levelScale;
+	if (_engine == GrainEngine::structureOfArrays){
+		_single_precision[slot] = (_precision == GrainPrecision::automatic)
+								&& (level.source.length <= GrainBank<float>::maxSourceLength);
+		if (_single_precision[slot]){
+			_bank_single->start(slot, spawn, level, _owner[slot]);
+		} else {
+			_bank->start(slot, spawn, level, _owner[slot]);
+		}
+	} else {
+		_players[slot].start(spawn, level, _window_table);
+	}
+}
+void GrainPool::release(std::size_t slot){
+	_players[slot].setIdle();
+	_bank->setIdle(slot);
+	_bank_single->setIdle(slot);
+	auto &partition = partitionFor(_owner[slot]);
+	partition.slots.release(slot - partition.first);
+}
+void GrainPool::releaseAll(int const owner){
+	auto &partition = partitionFor(owner);
+	auto const active = partition.slots.active();
+	for (std::size_t n = active.size(); n-- > 0;){	// backwards, since releasing swaps the last active index into slot n
+		if (_owner[partition.first + active[n]] == owner){
+			release(partition.first + active[n]);
+		}
+	}
+}
+void GrainPool::retarget(SourceLevels const &source){
+	for (auto const &partition : _partitions){
+		for (auto const local : partition.slots.active()){
+			std::size_t const slot = partition.first + local;
+			if (source.base.length == 0){	// nothing left to read
+				_players[slot].setIdle();
+				_bank->setIdle(slot);
+				_bank_single->setIdle(slot);
+			} else if (_engine != GrainEngine::structureOfArrays){
+				_players[slot].retarget(source);
+			} else if (_single_precision[slot]){
+				_bank_single->retarget(slot, source);
+			} else {
+				_bank->retarget(slot, source);
+			}
+		}
+	}
+}
+void GrainPool::render(int const owner, float *const outL, float *const outR, int const numSamples){
+	if ((numSamples <= 0) || (getNumActive(owner) == 0)){
+		return;
+	}
+	auto &partition = partitionFor(owner);
+	if ((_grain_workers != nullptr) && (numSamples >= _min_parallel_span) && (getNumActive(owner) >= _min_parallel_grains)){
+		renderParallel(partition, owner, outL, outR, numSamples);
+	} else if (_engine == GrainEngine::structureOfArrays){
+		// each bank skips lane groups with no sounding grain of this owner, so a bank nobody is using costs one scan
+		_bank_single->process(outL, outR, numSamples, owner, partition.first, partition.size, partition.rows);
+		_bank->process(outL, outR, numSamples, owner, partition.first, partition.size, partition.rows);
+	} else {
+		renderPlayers(partition.slots.active(), partition, owner, outL, outR, numSamples,
+					  partition.scratch_L.data(), partition.scratch_R.data());
+	}
+	auto const active = partition.slots.active();
+	for (std::size_t n = active.size(); n-- > 0;){
+		auto const local = active[n];
+		if ((_owner[partition.first + local] == owner) && isIdle(partition.first + local)){
+			partition.slots.release(local);
+		}
+	}
+}
+void GrainPool::renderPlayers(std::span<std::size_t const> const locals, Partition const &partition, int const owner,
+							  float *const outL, float *const outR, int const numSamples, float *const scratchL, float *const scratchR){
+	for (auto const local : locals){
+		std::size_t const slot = partition.first + local;
+		if (_owner[slot] != owner){
+			continue;
+		}
+		for (int start = 0; start < numSamples; start += maxRenderBlock){
+			_players[slot].processBlock(_window_table, outL + start, outR + start, scratchL, scratchR,
+										std::min(maxRenderBlock, numSamples - start), _interpolation);
+		}
+	}
+}
+void GrainPool::renderParallel(Partition const &partition, int const owner, float *const outL, float *const outR, int const numSamples){
+	constexpr std::size_t chunkSize {GrainRowScratch::laneWidth};	// one lane group, or as many players
+	bool const banked = (_engine == GrainEngine::structureOfArrays);
+	auto const active = partition.slots.active();
+	std::size_t const numItems = banked ? partition.size : active.size();
+	int const numChunks = static_cast<int>((numItems + chunkSize - 1) / chunkSize);
+	
+	for (int start = 0; start < numSamples; start += maxRenderBlock){
+		int const n = std::min(maxRenderBlock, numSamples - start);
+		auto job = [&](int const thread){
+			auto &ts = _thread_scratch[static_cast<std::size_t>(thread)];
+			std::fill_n(ts.out_L.begin(), n, 0.f);
+			std::fill_n(ts.out_R.begin(), n, 0.f);
+			while (auto const chunk = _chunks.next(thread)){
+				std::size_t const first = static_cast<std::size_t>(*chunk) * chunkSize;
+				if (banked){
+					_bank_single->process(ts.out_L.data(), ts.out_R.data(), n, owner, partition.first + first, chunkSize, ts.rows);
+					_bank->process(ts.out_L.data(), ts.out_R.data(), n, owner, partition.first + first, chunkSize, ts.rows);
+				} else {
+					renderPlayers(active.subspan(first, std::min(chunkSize, numItems - first)), partition, owner,
+								  ts.out_L.data(), ts.out_R.data(), n, ts.scratch_L.data(), ts.scratch_R.data());
+				}
+			}
+		};
+		_chunks.deal(numChunks);
+		_grain_workers->run(job);
+		for (auto const &ts : _thread_scratch){	// in thread order, though which grains each thread summed varies with the stealing
+			for (int i = 0; i < n; ++i){
+				outL[start + i] += ts.out_L[static_cast<std::size_t>(i)];
+				outR[start + i] += ts.out_R[static_cast<std::size_t>(i)];
+			}
+		}
+	}
+}
+std::size_t GrainPool::getNumActive(int const owner) const {
+	auto const &partition = partitionFor(owner);
+	auto const active = partition.slots.active();
+	return static_cast<std::size_t>(std::count_if(active.begin(), active.end(), [this, owner, &partition](std::size_t local){
+		return _owner[partition.first + local] == owner;
+	}));
+}
+bool GrainPool::isBusy(int const owner, int const spawner) const {
+	auto const &partition = partitionFor(owner);
+	for (auto const local : partition.slots.active()){
+		std::size_t const slot = partition.first + local;
+		if ((_owner[slot] == owner) && (_spawner[slot] == spawner)){
+			return true;
+		}
+	}
+	return false;
+}
+void GrainPool::describe(int const owner, std::span<GrainDescription> const bySpawner, std::size_t waveLength) const {
+	auto const &partition = partitionFor(owner);
+	for (auto const local : partition.slots.active()){
+		std::size_t const slot = partition.first + local;
+		auto const spawner = static_cast<std::size_t>(_spawner[slot]);
+		if ((_owner[slot] != owner) || (spawner >= bySpawner.size())){
+			continue;
+		}
+		GrainDescription gd = bySpawner[spawner];
+		if (_engine == GrainEngine::structureOfArrays){
+			if (_single_precision[slot]){
+				_bank_single->describe(slot, gd, waveLength);
+			} else {
+				_bank->describe(slot, gd, waveLength);
+			}
+		} else {
+			_players[slot].describe(gd, waveLength);
+		}
+		auto &entry = bySpawner[spawner];
+		if (!entry.busy || (gd.window > entry.window)){	// a spawner may have several grains sounding; show the loudest
+			entry = gd;
+			entry.busy = true;
+		}
+	}
+}
+}	// namespace nvs::gran
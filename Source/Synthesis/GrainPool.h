@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    GrainPool.h
+    Created: 16 Oct 2026 7:26:51pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include "GrainSpawn.h"
+#include "GrainSlots.h"
+#include "GrainAllocator.h"
+#include "GrainBank.h"
+#include "GrainWindow.h"
+#include "GrainDescription.h"
+#include "Interpolation.h"
+#include "RenderWorkers.h"
+#include "SourcePyramid.h"
+
+namespace nvs::gran {
+
+enum class GrainEngine {
+	scalar,				// one GrainPlayer object per grain; the reference implementation
+	structureOfArrays	// GrainBank; grains render in lockstep lanes
+};
+
+enum class GrainPrecision {	// of the structureOfArrays engine; the scalar engine is always double
+	automatic,		// single precision while the source is short enough for it (GrainBank<float>::maxSourceLength), double otherwise
+	doublePrecision	// always the reference GrainBank<double>
+};
+
+/**
+ Renders a single spawned grain, one sample at a time: accumulate -> window -> read -> pan.
+ */
+class GrainPlayer {
+public:
+	void start(GrainSpawn const &spawn, LevelView const &source, GrainWindowTable const &windowTable);	// spawn is in source's samples
+	bool isIdle() const;
+	void setIdle();
+	void retarget(SourceLevels const &source);	// see GrainPool::retarget()
+	/**
+	 Adds into outL/outR, stopping early once the grain has finished. The grain is rendered into scratchL/scratchR (numSamples long)
+	 and then shaped as a block. quality is resolved once here, into the matching render<>().
+	 */
+	void processBlock(GrainWindowTable const &windowTable, float *outL, float *outR, float *scratchL, float *scratchR, int numSamples,
+					  interp::Quality quality = interp::Quality::hermite);
+	void describe(GrainDescription &gd, std::size_t waveLength) const;
+private:
+	template <interp::Quality Q>
+	int render(GrainWindowTable const &windowTable, float *scratchL, float *scratchR, int numSamples);	// returns the samples rendered
+
+	GrainSpawn _spawn;
+	LevelView _source;
+	GrainWindowTable::Key _window_key;
+	float _gain_L {0.f};
+	float _gain_R {0.f};
+
+	bool _starting {false};
+	double _accum {0.0};
+	double _window_phase {1.0};	// at 1 the grain has finished
+	float _window {0.f};
+	double _sample_index {0.0};
+};
+
+/**
+ Synth-wide grain storage that voices borrow from. Each voice latches its grains' parameters itself (see Grain::spawn()),
+ then starts them on a free slot of the pool, so a single held note can use the budget that would otherwise sit idle in
+ other voices. Every slot remembers its owning voice and the spawner (the voice's Grain) it came from.
+ 
+ The slots are split into partitions, each with its own free list, allocator and scratch; owner n uses partition
+ n % getNumPartitions(). With one partition (the default) every voice borrows from the whole pool, and voices must render one
+ after another. With a partition per voice, each voice is limited to its share, but voices touch disjoint state and may
+ render concurrently.
+ */
+class GrainPool {
+public:
+	static constexpr int maxRenderBlock {512};	// render() works through longer spans in blocks of this
+	
+	GrainPool(std::size_t capacity, GrainWindowTable const &windowTable);
+
+	std::size_t getCapacity() const { return _players.size(); }	// may exceed the requested capacity, to keep partitions lane-aligned
+	void setCapacity(std::size_t capacity);	// reallocates and releases every slot; never call while rendering
+	void setPartitions(std::size_t numPartitions);	// likewise
+	std::size_t getNumPartitions() const { return _partitions.size(); }
+	std::size_t getPartitionSize(int owner) const { return partitionFor(owner).size; }	// how many grains owner can have sounding at once
+	void setEngine(GrainEngine engine) { _engine = engine; }
+	GrainEngine getEngine() const { return _engine; }
+	void setAllocation(GrainAllocation allocation) { _allocation = allocation; }
+	void setPrecision(GrainPrecision precision) { _precision = precision; }
+	void setInterpolation(interp::Quality quality);
+	interp::Quality getInterpolation() const { return _interpolation; }
+	
+	// Placeholders, not measurements: GrainPoolBench has only been run on a single-CPU machine, where the workers time-slice
+	// one core and parallel never pays, so nothing there places the crossover. Measure it on multi-core hardware and set these.
+	static constexpr std::size_t defaultMinParallelGrains {64};
+	static constexpr int defaultMinParallelSpan {64};
+	/**
+	 Lets render() spread one owner's grains over the threads of workers (which must already be started) once at least minGrains
+	 of them are sounding, for a span of at least minSpan samples: PolyGrain renders span by span between onsets, and below that
+	 the hand-off to the workers costs more than the span itself. The grains are cut into chunks, a bank lane group or as many
+	 players, which WorkStealingChunks balances between the threads; each thread adds into its own scratch, and those are summed
+	 into the output afterwards.
+	 Pass nullptr to render on the calling thread only. Allocates, so never call while rendering; and the workers must not
+	 also be rendering voices, since their jobs cannot nest.
+	 */
+	void setGrainWorkers(RenderWorkerPool *workers, std::size_t minGrains = defaultMinParallelGrains,
+						 int minSpan = defaultMinParallelSpan);
+
+	/** Reserves a free slot for owner, or returns nullopt if the whole pool is busy. Follow with start() or release(). */
+	template <typename URBG>
+	std::optional<std::size_t> acquire(int owner, int spawner, URBG &rng){
+		auto &partition = partitionFor(owner);
+		auto const local = partition.allocator.choose(_allocation, partition.slots, rng);
+		if (!local){
+			return std::nullopt;
+		}
+		partition.slots.activate(*local);
+		partition.allocator.noteStarted(*local);
+		std::size_t const slot = partition.first + *local;
+		_owner[slot] = owner;
+		_spawner[slot] = spawner;
+		return slot;
+	}
+	/**
+	 Starts spawn on slot, reading from the source level that matches its stride (see SourceLevels::levelFor); that level's
+	 length also decides the grain's precision. The grain latches the level, and reads it until it ends.
+	 */
+	void start(std::size_t slot, GrainSpawn spawn, SourceLevels const &source);
+	void release(std::size_t slot);
+	void releaseAll(int owner);
+	/**
+	 Moves every sounding grain onto source, which replaces the one they latched; call it before the old frames or octaves
+	 are freed, and never while rendering. A grain keeps its level where source has the same level of the same length (the
+	 octaves rebuilt, or a new file of the same length), and otherwise carries on from the same position in level 0.
+	 */
+	void retarget(SourceLevels const &source);
+
+	void render(int owner, float *outL, float *outR, int numSamples);	// adds into outL/outR
+
+	std::size_t getNumActive(int owner) const;
+	bool isBusy(int owner, int spawner) const;
+	/**
+	 Fills bySpawner[s] for every spawner s of owner with a grain on the pool: the one whose window is highest, marked busy (as
+	 isBusy() would). Entries of spawners with nothing on the pool are left as they are.
+	 */
+	void describe(int owner, std::span<GrainDescription> bySpawner, std::size_t waveLength) const;
+private:
+	GrainWindowTable const &_window_table;
+	GrainEngine _engine {GrainEngine::scalar};
+	GrainAllocation _allocation {GrainAllocation::randomFree};
+	GrainPrecision _precision {GrainPrecision::automatic};
+	interp::Quality _interpolation {interp::Quality::hermite};
+
+	struct Partition {
+		Partition(std::size_t firstSlot, std::size_t numSlots);
+		std::size_t first;	// slot = first + local index
+		std::size_t size;
+		GrainSlots slots;	// local indices
+		GrainAllocator allocator;
+		std::vector<float> scratch_L;	// for GrainPlayer
+		std::vector<float> scratch_R;
+		GrainRowScratch rows;	// for the banks
+	};
+	std::size_t _requested_capacity {0};
+	std::vector<Partition> _partitions;
+	std::vector<int> _owner;
+	std::vector<int> _spawner;
+
+	std::vector<GrainPlayer> _players;
+	std::vector<std::uint8_t> _single_precision;	// per slot: which bank its grain was started on (bytes, not vector<bool>, so partitions never share a word)
+	std::unique_ptr<GrainBank<double>> _bank;
+	std::unique_ptr<GrainBank<float>> _bank_single;
+	
+	struct ThreadScratch {	// one grain-rendering thread's output and working buffers
+		ThreadScratch();
+		std::vector<float> out_L;
+		std::vector<float> out_R;
+		std::vector<float> scratch_L;
+		std::vector<float> scratch_R;
+		GrainRowScratch rows;
+	};
+	RenderWorkerPool *_grain_workers {nullptr};
+	std::size_t _min_parallel_grains {defaultMinParallelGrains};
+	int _min_parallel_span {defaultMinParallelSpan};
+	std::vector<ThreadScratch> _thread_scratch;
+	WorkStealingChunks _chunks;
+
+	void renderPlayers(std::span<std::size_t const> locals, Partition const &partition, int owner,
+					   float *outL, float *outR, int numSamples, float *scratchL, float *scratchR);
+	void renderParallel(Partition const &partition, int owner, float *outL, float *outR, int numSamples);
+
+	void allocate(std::size_t capacity, std::size_t numPartitions);
+	Partition &partitionFor(int owner);
+	Partition const &partitionFor(int owner) const;
+	bool isIdle(std::size_t slot) const;
+};
+}	// namespace nvs::gran
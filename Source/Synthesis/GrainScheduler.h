@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    GrainScheduler.h
+    Created: 16 Oct 2026 6:12:44pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+namespace nvs::gran {
+
+struct GrainOnset {
+	int offset;	// sample within the scheduled block at which a grain starts
+};
+
+/**
+ Computes a block's grain onsets ahead of rendering, replacing the per-sample phasor -> ramp2trig -> history chain.
+ The trigger phase still advances by speed / sample rate per sample and a grain starts on every sample at which it wraps,
+ and the speed is re-latched on the sample after each onset; but the number of samples until the next wrap is solved directly,
+ so the cost is per onset rather than per sample. Onsets come out sorted, at most one per sample.
+ */
+class GrainScheduler {
+public:
+	static constexpr int maxBlockSize {512};	// longer blocks are scheduled in several passes
+	static constexpr double periodTolerance {1e-9};	// in samples
+
+	GrainScheduler(){
+		_onsets.reserve(maxBlockSize);
+	}
+	void setSampleRate(double sampleRate){
+		assert (sampleRate > 0.0);
+		_sample_rate = sampleRate;
+	}
+	void reset(){	// (note on) the next block starts with an onset, then runs from phase 0
+		_phase = 0.0;
+		_onset_pending = true;
+	}
+	/**
+	 Schedules the next numSamples samples. nextSpeed() is called whenever the speed latches (after each onset), and returns Hz.
+	 */
+	template <typename NextSpeed>
+	std::span<GrainOnset const> schedule(int const numSamples, NextSpeed &&nextSpeed){
+		assert (numSamples <= maxBlockSize);
+		_onsets.clear();
+		int i = 0;
+		if (_onset_pending && numSamples > 0){
+			_onset_pending = false;
+			_onsets.push_back({0});
+			_relatch = true;
+			i = 1;
+		}
+		while (i < numSamples){
+			if (_relatch){
+				_increment = nextSpeed() / _sample_rate;
+				_relatch = false;
+			}
+			if (!(_increment > 0.0)){
+				break;
+			}
+			// smallest k >= 1 for which the phase reaches 1 on the k-th sample from here.
+			// the tolerance keeps integer periods (e.g. 1000 Hz at 48 kHz) from rounding up by a sample
+			double const k = std::max(1.0, std::ceil((1.0 - _phase) / _increment - periodTolerance));
+			if (k > static_cast<double>(numSamples - i)){
+				_phase += static_cast<double>(numSamples - i) * _increment;
+				break;
+			}
+			i += static_cast<int>(k);
+			_phase = std::max(0.0, _phase + k * _increment - 1.0);
+			_phase -= std::floor(_phase);	// speeds above the sample rate wrap more than once, but trigger once
+			_onsets.push_back({i - 1});
+			_relatch = true;
+		}
+		return _onsets;
+	}
+private:
+	std::vector<GrainOnset> _onsets;
+	double _sample_rate {44100.0};
+	double _phase {0.0};
+	double _increment {0.0};
+	bool _relatch {true};
+	bool _onset_pending {false};
+};
+}	// namespace nvs::gran
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    GrainSlots.h
+    Created: 16 Oct 2026 4:05:37pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <vector>
+#include <span>
+#include <cassert>
+
+namespace nvs::gran {
+/**
+ Partitions grain indices into a compact active list and a free list, so that rendering only visits sounding grains
+ and a trigger can go straight to a free one. Moving an index between the lists is O(1) (swap with the back);
+ neither list ever reallocates after construction.
+ */
+class GrainSlots {
+public:
+	explicit GrainSlots(std::size_t numGrains)
+	:	_position(numGrains)
+	,	_is_active(numGrains)
+	{
+		_active.reserve(numGrains);
+		_free.reserve(numGrains);
+		reset();
+	}
+	void reset(){	// every grain free
+		_active.clear();
+		_free.clear();
+		for (std::size_t idx = 0; idx < _position.size(); ++idx){
+			_position[idx] = _free.size();
+			_is_active[idx] = false;
+			_free.push_back(idx);
+		}
+	}
+	void activate(std::size_t idx){
+		assert (!_is_active[idx]);
+		move(idx, _free, _active);
+		_is_active[idx] = true;
+	}
+	void release(std::size_t idx){
+		assert (_is_active[idx]);
+		move(idx, _active, _free);
+		_is_active[idx] = false;
+	}
+	bool isActive(std::size_t idx) const { return _is_active[idx]; }
+	std::span<std::size_t const> active() const { return _active; }
+	std::span<std::size_t const> free() const { return _free; }
+private:
+	std::vector<std::size_t> _active;
+	std::vector<std::size_t> _free;
+	std::vector<std::size_t> _position;	// where each grain index sits in whichever list currently holds it
+	std::vector<bool> _is_active;
+
+	void move(std::size_t idx, std::vector<std::size_t> &from, std::vector<std::size_t> &to){
+		std::size_t const pos = _position[idx];
+		assert (pos < from.size() && from[pos] == idx);
+		std::size_t const last = from.back();
+		from[pos] = last;
+		_position[last] = pos;
+		from.pop_back();
+		_position[idx] = to.size();
+		to.push_back(idx);
+	}
+};
+}	// namespace nvs::gran
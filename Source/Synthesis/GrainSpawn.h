@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+    GrainSpawn.h
+    Created: 16 Oct 2026 10:31:47am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace nvs::gran {
+/**
+ Everything about a grain that is fixed for its whole lifetime, resolved once when the grain is triggered.
+ Per sample, a grain then only needs its accumulator:
+	window phase = accum / window_length
+	source index = index_origin + index_rate * accum
+ */
+struct GrainSpawn {
+	double read_rate {1.0};		// accumulator increment per output sample (note ratio * transposition)
+	double window_length {1.0};	// accumulator span of the whole window (duration in samples * duration pitch compensation)
+	double index_origin {0.0};	// source sample index at accum == 0
+	double index_rate {1.0};	// source samples per accumulator unit (file sample rate / playback sample rate)
+	int level {0};				// the SourceLevels level read; index_origin and index_rate are in that level's samples
+	float skew {0.5f};
+	float plateau {1.f};
+	float amplitude {0.f};
+	float pan {0.f};			// radians, 0 (left) to pi/2 (right)
+	float gain_L {1.f};			// pan resolved through the synth's PanLaw
+	float gain_R {0.f};
+	float drive {1.f};
+	float makeup_gain {1.f};
+	float shaper_gain {1.f};	// makeup gain over the drive normalization, see shaper::outputGain()
+};
+}	// namespace nvs::gran
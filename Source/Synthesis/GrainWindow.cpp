@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    GrainWindow.cpp
+    Created: 16 Oct 2026 2:40:11pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "GrainWindow.h"
+#include <algorithm>
+
+namespace nvs::gran {
+
+float GrainWindowTable::plateauForRow(float const row){
+	return minPlateau * std::pow(10.f, row / static_cast<float>(rowsPerDecade));
+}
+
+GrainWindowTable::GrainWindowTable()
+:	_table(static_cast<size_t>((numPlateaus + 2) * rowStride))
+{
+	for (int r = 0; r < numPlateaus + 2; ++r){
+		float const plateau = plateauForRow(static_cast<float>(std::min(r, numPlateaus)));
+		float *const row = _table.data() + r * rowStride;
+		for (int i = 0; i <= numPoints; ++i){
+			row[i] = shapeWindow(static_cast<float>(i) / static_cast<float>(numPoints), plateau);
+		}
+		row[numPoints + 1] = row[numPoints];
+	}
+	
+	// measure the bound at cell centres, both along the row and between plateau rows
+	for (int r = 0; r < numPlateaus; ++r){
+		Key key;
+		key.row = r;
+		key.row_frac = 0.5f;
+		key.plateau = plateauForRow(static_cast<float>(r) + 0.5f);
+		for (int i = 0; i < numPoints; ++i){
+			float const triangle = (static_cast<float>(i) + 0.5f) / static_cast<float>(numPoints);
+			float const err = std::abs((*this)(key, triangle) - shapeWindow(triangle, key.plateau));
+			_max_error = std::max(_max_error, err);
+		}
+	}
+}
+
+GrainWindowTable::Key GrainWindowTable::makeKey(float const plateau) const {
+	Key key;
+	key.plateau = plateau;
+	if (!(plateau >= minPlateau && plateau <= maxPlateau)){
+		return key;	// analytic
+	}
+	float const pos = static_cast<float>(rowsPerDecade) * std::log10(plateau / minPlateau);
+	key.row = std::clamp(static_cast<int>(pos), 0, numPlateaus);
+	key.row_frac = std::clamp(pos - static_cast<float>(key.row), 0.f, 1.f);
+	if (key.row_frac < 1e-4f){	// snap to a row, so that plateaus landing on the grid are read from a single table
+		key.row_frac = 0.f;
+	}
+	return key;
+}
+}	// namespace nvs::gran
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    GrainWindow.h
+    Created: 16 Oct 2026 10:12:03am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <cmath>
+#include <vector>
+#include <JuceHeader.h>
+#include "../dsp_util.h"
+#include "../../nvs_libraries/nvs_libraries/include/nvs_gen.h"
+
+namespace nvs::gran {
+inline float shapeWindow(float win, float plateau){	// everything after the triangle
+	using nvs::util::tanh_pade_3_2;
+	plateau = memoryless::clamp_low(plateau, 0.000001f);
+	win *= plateau;
+	win = gen::parzen(tanh_pade_3_2(win)) / gen::parzen(tanh_pade_3_2(plateau));
+	if (plateau < 1.0){
+		win = std::pow(win, 1.f / plateau);
+	}
+	return win;
+}
+/**
+ The analytic grain window, against which GrainWindowTable is built and checked.
+ windowIdx is the normalized position within the window (0 to 1), skew places the peak, and plateau < 1 narrows / > 1 flattens the top.
+ */
+inline float calculateWindow(double const windowIdx, float const skew, float const plateau){
+	return shapeWindow(nvs::gen::triangle<float, false>(static_cast<float>(windowIdx), skew), plateau);
+}
+
+/**
+ Precomputed grain windows, so that grains do not evaluate tanh, parzen and pow every sample.
+ Skew only enters the window through the (piecewise linear) triangle, so it stays exact and the tables are indexed by the triangle's
+ output instead of by phase. Tables are therefore only keyed on plateau: numPlateaus + 1 log-spaced rows between minPlateau and
+ maxPlateau, each with numPoints linear segments (about 0.8 MB in total). Lookups interpolate linearly along the row and between the two neighbouring rows.
+ 
+ Error bound: linear interpolation deviates from the analytic window by at most h^2/8 * max|d2w/dt2| along a row (h = 1/numPoints),
+ plus the corresponding term across plateau rows. Rather than trusting the derivative estimate, the constructor measures the
+ absolute deviation at every cell centre, between every pair of rows, and getMaxError() reports the worst.
+ For the shipped grid that is about 0.009 of full scale, in the lowest decade of plateaus (0.01 to 0.1), where
+ pow(w, 1 / plateau) is steepest; sampled densely off the cell centres it stays below 0.0093 there, and below 0.00025 for
+ plateaus of 0.1 and up. maxError is the figure these are held to (see GrainWindowBench).
+ Plateaus outside of [minPlateau, maxPlateau] (reachable only through randomization) fall back to the analytic window.
+ 
+ Building all rows is not real-time safe; construct once, off the audio thread.
+ */
+class GrainWindowTable {
+public:
+	static constexpr int numPoints {1024};
+	static constexpr int rowsPerDecade {64};	// decade-aligned, so that the default plateau of 1 falls exactly on a row
+	static constexpr float minPlateau {0.01f};
+	static constexpr float maxPlateau {10.f};
+	static constexpr int numPlateaus {3 * rowsPerDecade};	// log10(maxPlateau / minPlateau) decades
+	static constexpr float maxError {0.01f};	// bounds getMaxError(), and the deviation anywhere on the grid
+	
+	GrainWindowTable();
+	
+	struct Key {		// resolved once per grain, when its plateau is latched
+		int row {-1};	// -1: analytic
+		float row_frac {0.f};
+		float plateau {1.f};
+	};
+	Key makeKey(float plateau) const;
+	
+	float operator()(Key const &key, float triangle) const {
+		if (key.row < 0){
+			return shapeWindow(triangle, key.plateau);
+		}
+		float const x = triangle * static_cast<float>(numPoints);
+		int const i = static_cast<int>(x);
+		float const f = x - static_cast<float>(i);
+		float const *const row_0 = _table.data() + key.row * rowStride;
+		float const *const row_1 = row_0 + rowStride;
+		float const a = row_0[i] + f * (row_0[i + 1] - row_0[i]);
+		float const b = row_1[i] + f * (row_1[i + 1] - row_1[i]);
+		return a + key.row_frac * (b - a);
+	}
+	float window(Key const &key, double const windowIdx, float const skew) const {
+		return (*this)(key, nvs::gen::triangle<float, false>(static_cast<float>(windowIdx), skew));
+	}
+	float getMaxError() const { return _max_error; }
+private:
+	static constexpr int rowStride {numPoints + 2};	// one guard point, so that triangle == 1 can read i + 1
+	std::vector<float> _table;	// (numPlateaus + 2) rows, the last one duplicating maxPlateau as a guard
+	float _max_error {0.f};
+	
+	static float plateauForRow(float row);
+};
+}	// namespace nvs::gran
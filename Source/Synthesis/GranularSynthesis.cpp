@@ -17,6 +17,7 @@
  */
 
 #include "GranularSynthesis.h"
+#include "GrainWindow.h"
 #include "../dsp_util.h"
 #include "../algo_util.h"
 #include <numbers>
@@ -131,20 +132,19 @@ PolyGrain::PolyGrain(GranularSynthSharedState *const synth_shared_state,
 :
 _synth_shared_state { synth_shared_state },
 _voice_shared_state(voice_shared_state),
-_normalizer(1.f / std::sqrt(static_cast<float>(std::clamp(N_GRAINS, 1UL, 10000UL)))),
-_grain_indices(N_GRAINS),
+_pool(synth_shared_state->_grain_pool),
 _speed_ler(_voice_shared_state->_expo_rng,  {10.f, 0.f})
 {
 	assert (_grains.size() == 0);
-	_grains.reserve(N_GRAINS);
-	for (size_t i = 0; i < N_GRAINS; ++i){
+	size_t const numGrains = _synth_shared_state->_settings._grains_per_voice;
+	_grains.reserve(numGrains);
+	for (size_t i = 0; i < numGrains; ++i){
 		_grains.emplace_back(_synth_shared_state, _voice_shared_state, i);
 	}
-	std::iota(_grain_indices.begin(), _grain_indices.end(), 0);
 }
 void PolyGrain::setSampleRate(double sample_rate){
 	assert(_synth_shared_state);
-	_phasor_internal_trig.setSampleRate(sample_rate);
+	_scheduler.setSampleRate(sample_rate);
 	_voice_shared_state->_scanner.setSampleRate(sample_rate);
 	_synth_shared_state->_playback_sample_rate = sample_rate;
 }
@@ -196,7 +196,7 @@ void PolyGrain::doNoteOn(noteNumber_t note, velocity_t velocity){
 
 	_note_holder.insert(p);
 	updateNotes();
-	_phasor_internal_trig.reset();
+	_scheduler.reset();
 	_voice_shared_state->_scanner.reset();
 	
 #if GRAIN_UPDATE_HACK
@@ -215,7 +215,7 @@ void PolyGrain::doNoteOff(noteNumber_t note){
 }
 void PolyGrain::doUpdateNotes(){
 	size_t num_notes = _note_holder.size();
-	float grainsPerNoteFloor = N_GRAINS / static_cast<float>(num_notes);
+	float grainsPerNoteFloor = _grains.size() / static_cast<float>(num_notes);
 
 	auto begin = _grains.begin();
 	float fractional_right_side = 0.f;
@@ -236,30 +236,24 @@ void PolyGrain::doUpdateNotes(){
 void PolyGrain::doClearNotes(){
 	_note_holder.clear();
 }
-void PolyGrain::doShuffleIndices(){
-	std::shuffle(_grain_indices.begin(), _grain_indices.end(),
-				 _voice_shared_state->_gaussian_rng.getGenerator());
-}
-std::vector<float> PolyGrain::getBusyStatuses() const {
+std::vector<float> PolyGrain::getBusyStatuses() const {	// per spawner: whether any grain it started is still sounding
 	std::vector<float> busyStatuses;
-	busyStatuses.reserve(N_GRAINS);
+	busyStatuses.reserve(_grains.size());
 	for (auto const &g : _grains){
-		busyStatuses.push_back(g.getBusyStatus());
+		busyStatuses.push_back(static_cast<float>(_pool.isBusy(getOwnerId(), g.getId())));
 	}
 	return busyStatuses;
 }
 void PolyGrain::setGrainsIdle() {
-	for (auto &g : _grains){
-		g.setBusyStatus(false);
-	}
+	_pool.releaseAll(getOwnerId());
 }
 
 void PolyGrain::setParams() {
-	auto const &apvts = _synth_shared_state->_apvts;
-	_speed_ler.setMu(*apvts.getRawParameterValue("speed"));
-	_speed_ler.setSigma(*apvts.getRawParameterValue("speed_rand"));
-	_voice_shared_state->_scanner._freq = *apvts.getRawParameterValue("scanner_rate");
-	_voice_shared_state->_scanner_amount = *apvts.getRawParameterValue("scanner_amount");
+	auto const &params = _synth_shared_state->_params;
+	_speed_ler.setMu(params.speed);
+	_speed_ler.setSigma(params.speed_rand);
+	_voice_shared_state->_scanner._freq = params.scanner_rate;
+	_voice_shared_state->_scanner_amount = params.scanner_amount.end;	// startGrain() places it on the ramp
 	
 	for (auto &g : _grains){
 		g.setParams();
@@ -270,78 +264,159 @@ std::array<float, 2> PolyGrain::operator()(float triggerIn){
 	return doProcess(triggerIn);
 }
 
-std::array<float, 2> PolyGrain::doProcess(float trigger_in){
-	std::array<float, 2> output {0.f, 0.f};
-	
-	// update phasor's frequency only if _triggerHisto.val is true
-	float const freq_tmp = _speed_ler(static_cast<bool>(_trigger_histo.val)); // used to clamp by percentage of mu. should no longer be necessary.
-	_phasor_internal_trig.setFrequency(freq_tmp);
-	++_phasor_internal_trig;
-	float trig = _ramp2trig(_phasor_internal_trig.getPhase());
-	_trigger_histo(trig);
-	trig = (!trig && !trigger_in) ? 0.f : 1.f;
-	
-	_voice_shared_state->_scanner.phasor();	// increment scanner phase per sample
-
-	std::array<Grain::outs, N_GRAINS> _outs;
-
-#pragma message("trying shuffle, may cause bugs (so far seems fine but keeping warning here until i can be completely sure)")
-	shuffleIndices();
+void PolyGrain::advanceScanner(int const numSamples){
+	for (int i = 0; i < numSamples; ++i){
+		_voice_shared_state->_scanner.phasor();	// increment scanner phase per sample
+	}
+}
+void PolyGrain::startGrain(int const sampleInBlock){
+	// the pool's allocation policy picks the slot; if the voice's partition of the pool is full, the onset is dropped. Its spawn
+	// count is spent all the same, so whether an onset drops never shifts the random streams of the spawns after it.
+	auto &spawner = _grains[_next_spawner];
+	bool const counterBased = (_synth_shared_state->_settings._random_streams == RandomStreams::counterBased);
+	seekRandomStream(static_cast<std::uint32_t>(spawner.getId()), spawner.nextSpawnCount());
+	auto const slot = counterBased ? _pool.acquire(getOwnerId(), spawner.getId(), _voice_shared_state->_counter_rng)
+								   : _pool.acquire(getOwnerId(), spawner.getId(), _voice_shared_state->_gaussian_rng.getGenerator());
+	if (!slot){
+		return;
+	}
+	_next_spawner = (_next_spawner + 1) % _grains.size();
+	float const rampPhase = _synth_shared_state->_params.rampPhase(sampleInBlock);
+	_voice_shared_state->_scanner_amount = _synth_shared_state->_params.scanner_amount.at(rampPhase);
+	auto const spawn = spawner.spawn(rampPhase);
+	if (!spawn){
+		_pool.release(*slot);
+		return;
+	}
+	_pool.start(*slot, *spawn, _synth_shared_state->_buffer.levels());
+}
+void PolyGrain::seekRandomStream(std::uint32_t const stream, std::uint32_t const event){
+	if (_synth_shared_state->_settings._random_streams == RandomStreams::counterBased){
+		_voice_shared_state->_counter_rng.seek(static_cast<std::uint32_t>(getOwnerId()), stream, event);
+	}
+}
+void PolyGrain::renderGrains(float *const outL, float *const outR, int const numSamples){
+	_pool.render(getOwnerId(), outL, outR, numSamples);
+}
+void PolyGrain::processBlock(float *const outL, float *const outR, int const numSamples){
+	std::fill(outL, outL + numSamples, 0.f);
+	std::fill(outR, outR + numSamples, 0.f);
+	_voice_shared_state->selectRandomStreams(_synth_shared_state->_settings);
+	updateNormalizer();
+	if (_synth_shared_state->_settings._random_streams == RandomStreams::perVoice){
+		// top up the voice's random rings in bulk, so that latching a random value is a read
+		_voice_shared_state->_gaussian_rng.refill();
+		_voice_shared_state->_expo_rng.refill();
+	}
 	
-	size_t idx = _grain_indices[0];
-	_outs[idx] = _grains[idx](trig);
-	float audio_out_L = _outs[idx].audio_L;
-	float audio_out_R = _outs[idx].audio_R;
-	float voices_active = _outs[idx].busy;
+	for (int start = 0; start < numSamples; start += GrainScheduler::maxBlockSize){
+		int const n = std::min(numSamples - start, GrainScheduler::maxBlockSize);
+		renderScheduled(outL + start, outR + start, n);
+		_ramp_position += n;
+	}
 	
-
-	for (size_t i = 1; i < N_GRAINS; ++i){
-		idx = _grain_indices.data()[i];
-		size_t prevIdx = _grain_indices.data()[i - 1];
-		
-		float currentTrig = _outs[prevIdx].next;
-		_outs[idx] = _grains[idx](currentTrig);
-		audio_out_L += _outs[idx].audio_L;
-		audio_out_R += _outs[idx].audio_R;
-		voices_active += _outs[idx].busy;
+	for (int i = 0; i < numSamples; ++i){
+		outL[i] *= _normalizer;
+		outR[i] *= _normalizer;
+	}
+	guardNonFinite(outL, outR, numSamples);
+}
+void PolyGrain::updateNormalizer(){
+	// the voice may have up to its whole partition sounding, not just one grain per spawner
+	auto const budget = _pool.getPartitionSize(getOwnerId());
+	if (budget != _normalizer_budget){
+		_normalizer_budget = budget;
+		_normalizer = 1.f / std::sqrt(static_cast<float>(std::max(budget, std::size_t{1})));
+	}
+}
+void PolyGrain::guardNonFinite(float *const outL, float *const outR, int const numSamples){
+	auto const n = static_cast<std::size_t>(numSamples);
+	if (!nvs::util::anyNonFinite(outL, n) && !nvs::util::anyNonFinite(outR, n)){
+		return;
 	}
-	output[0] = audio_out_L * _normalizer;
-	output[1] = audio_out_R * _normalizer;
+	std::fill(outL, outL + numSamples, 0.f);
+	std::fill(outR, outR + numSamples, 0.f);
+	auto &report = _synth_shared_state->_non_finite;
+	report._last_voice.store(getOwnerId(), std::memory_order_relaxed);
+	report._blocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PolyGrain::renderScheduled(float *const outL, float *const outR, int const numSamples){
+	auto const onsets = _scheduler.schedule(numSamples, [this](){
+		seekRandomStream(schedulerStream, _onset_count++);
+		return _speed_ler(true);	// re-latched once per onset
+	});
+	int rendered = 0;
+	int scanned = 0;
+	for (auto const onset : onsets){
+		// the scanner is brought up to (and including) the onset sample, since the new grain latches its position
+		advanceScanner(onset.offset + 1 - scanned);
+		scanned = onset.offset + 1;
+		// bring every sounding grain up to the onset, so that 'idle' reflects the state just before it
+		renderGrains(outL + rendered, outR + rendered, onset.offset - rendered);
+		rendered = onset.offset;
+		startGrain(_ramp_position + onset.offset);
+	}
+	advanceScanner(numSamples - scanned);
+	renderGrains(outL + rendered, outR + rendered, numSamples - rendered);
+}
 
-	if (nvs::util::checkNanOrInf(output)){
-		return {};
+std::array<float, 2> PolyGrain::doProcess(float trigger_in){
+	_voice_shared_state->selectRandomStreams(_synth_shared_state->_settings);
+	updateNormalizer();
+	bool const trig = !_scheduler.schedule(1, [this](){
+		seekRandomStream(schedulerStream, _onset_count++);
+		return _speed_ler(true);
+	}).empty()
+					|| static_cast<bool>(trigger_in);
+	advanceScanner(1);
+	if (trig){
+		startGrain(_ramp_position);
 	}
+	++_ramp_position;
+	std::array<float, 2> output {0.f, 0.f};
+	renderGrains(&output[0], &output[1], 1);
+	output[0] *= _normalizer;
+	output[1] *= _normalizer;
+	guardNonFinite(&output[0], &output[1], 1);
 	return output;
 }
 
-std::vector<GrainDescription> PolyGrain::getGrainDescriptions() const {
-	std::vector<GrainDescription> gds(N_GRAINS);
-	for (size_t i = 0; i < N_GRAINS; ++i){
-		gds[i] = _grains[i].getGrainDescription();
+void PolyGrain::getGrainDescriptions(std::vector<GrainDescription> &gds) const {
+	gds.clear();
+	for (auto const &g : _grains){
+		GrainDescription gd;
+		gd.voice = getOwnerId();
+		gd.grain_id = g.getId();
+		gd.position = 0.0;
+		gd.sample_playback_rate = 1.0;
+		gd.window = 0.f;
+		gd.pan = 0.5f;
+		gd.busy = false;
+		gd.first_playthrough = false;
+		gds.push_back(gd);
 	}
-	assert(gds.size() == N_GRAINS);
-	return gds;
+	_pool.describe(getOwnerId(), gds, _synth_shared_state->_buffer._frames.getLength());	// spawner ids index gds
 }
 
 //=====================================================================================
 void Grain::setParams(){
-	auto const &apvts = _synth_shared_state->_apvts;
-	_transpose_lgr.setMu(*apvts.getRawParameterValue("transpose"));
-	_transpose_lgr.setSigma(24.0f * (*apvts.getRawParameterValue("transpose_rand")));
-	_duration_ler.setMu(*apvts.getRawParameterValue("duration"));
-	_duration_ler.setSigma(*apvts.getRawParameterValue("duration_rand"));
-	float const pos = *apvts.getRawParameterValue("position");
-	_position_lgr.setMu(pos);
-	_position_lgr.setSigma(*apvts.getRawParameterValue("position_rand"));
-	_skew_lgr.setMu(*apvts.getRawParameterValue("skew"));
-	_skew_lgr.setSigma(*apvts.getRawParameterValue("skew_rand"));
-	_plateau_lgr.setMu(*apvts.getRawParameterValue("plateau"));
-	_plateau_lgr.setSigma(*apvts.getRawParameterValue("plateau_rand"));
-	_pan_lgr.setMu(1.f - *apvts.getRawParameterValue("pan"));	// makes more sense internally to reverse this
-	_pan_lgr.setSigma(*apvts.getRawParameterValue("pan_rand"));
+	auto const &params = _synth_shared_state->_params;
+	_transpose_lgr.setMu(params.transpose);
+	_transpose_lgr.setSigma(24.0f * params.transpose_rand);
+	_duration_ler.setMu(params.duration);
+	_duration_ler.setSigma(params.duration_rand);
+	_position_lgr.setMu(params.position.end);	// spawn() places it on the ramp
+	_position_lgr.setSigma(params.position_rand);
+	_skew_lgr.setMu(params.skew);
+	_skew_lgr.setSigma(params.skew_rand);
+	_plateau_lgr.setMu(params.plateau);
+	_plateau_lgr.setSigma(params.plateau_rand);
+	_pan_lgr.setMu(1.f - params.pan);	// makes more sense internally to reverse this
+	_pan_lgr.setSigma(params.pan_rand);
 	
-	_grain_drive = *apvts.getRawParameterValue("fx_grain_drive");
-	_grain_makeup_gain = *apvts.getRawParameterValue("fx_makeup_gain");
+	_grain_drive = params.fx_grain_drive.end;
+	_grain_makeup_gain = params.fx_makeup_gain.end;
 }
 
 Grain::Grain(GranularSynthSharedState *const synth_shared_state,
@@ -373,33 +448,6 @@ void Grain::setId(int newId){
 	_grain_id = newId;
 }
 
-float Grain::getBusyStatus() const {
-	return _busy_histo.val;
-}
-void Grain::setBusyStatus(bool newBusyStatus) {
-	_busy_histo.val = static_cast<float>(newBusyStatus);
-}
-
-GrainDescription Grain::getGrainDescription() const {
-	assert(_synth_shared_state);
-	auto const N = _synth_shared_state->_buffer._wave_block.getNumSamples();
-
-	GrainDescription gd;
-	gd.voice = _voice_shared_state->_voice_id;
-	gd.grain_id = _grain_id;
-	gd.position = nvs::gen::wrap01(_sample_index / N);
-	gd.sample_playback_rate = _waveform_read_rate;
-	gd.window = _window;
-	gd.pan = _pan / (std::numbers::pi * 0.5f);
-	gd.busy = _busy_histo.val != 0.f;
-#if GRAIN_UPDATE_HACK
-	gd.first_playthrough = firstPlaythroughOfVoicesNote;
-#else
-	gd.first_playthrough = false;
-#endif
-	return gd;
-}
-
 namespace {	// anonymous namespace for local helper functions
 float calculateTransposeMultiplier(float const ratioBasedOnNote, float const ratioBasedOnTranspose){
 	return memoryless::clamp(ratioBasedOnNote * ratioBasedOnTranspose, 0.001f, 1000.f);
@@ -415,25 +463,20 @@ double calculateDurationInSamples(double latchedDuration, double compensatedLeng
 //	auto const clippedLength = clamp(compensatedLength, minLengthInSamples, maxLengthInSamples);
 	return clamp(clippedNormalizedDuration * compensatedLength, minLengthInSamples, maxLengthInSamples);
 }
-float calculateWindow(double const accum, double const duration, float const transpositionMultiplier, float const skew, float plateau){
-	assert(transpositionMultiplier > 0.f);
-	assert (duration > 0.0);
-	double const v = (accum / duration);
-	double const windowIdx = nvs::memoryless::clamp(v / transpositionMultiplier, 0.0, 1.0);
-	float win = nvs::gen::triangle<float, false>(static_cast<float>(windowIdx), skew);
-	
-	plateau = memoryless::clamp_low(plateau, 0.000001f);
-	win *= plateau;
-#define tanh nvs::util::tanh_pade_3_2
-	win = gen::parzen(tanh(win)) / gen::parzen(tanh(plateau));
-	if (plateau < 1.0){
-#if pade
-		win = nvs::util::pow_pade(win, 1.f / plateau);
-#else
-		win = pow(win, 1.f / plateau);
-#endif
+ReadBounds denormalizeReadBounds(ReadBounds const normalizedReadBounds, size_t const buffLength){
+	ReadBounds denormedReadBounds = normalizedReadBounds * static_cast<double>(buffLength);
+	if (denormedReadBounds.end < denormedReadBounds.begin){
+		denormedReadBounds.end += buffLength;	// now this can be longer than the actual number of samples in the buffer. should be taken care of by wrapping in peek().
+		assert (denormedReadBounds.end > denormedReadBounds.begin);
 	}
-	return win;
+	return denormedReadBounds;
+}
+size_t calculateCompensatedLength(float const dur_dep_on_read_bounds, ReadBounds const &denormedReadBounds,
+								  size_t const buffLength, double const file_sample_rate_compensate_ratio){
+	size_t const event_length = denormedReadBounds.end - denormedReadBounds.begin;
+	size_t const cLen = static_cast<size_t>(nvs::memoryless::linterp((float)buffLength, (float)event_length, dur_dep_on_read_bounds) / file_sample_rate_compensate_ratio);
+	assert (0 < cLen);
+	return cLen;
 }
 double calculateSampleReadRate(double const playback_sample_rate, double const file_sample_rate){
 	assert(playback_sample_rate > 0.0);
@@ -464,171 +507,97 @@ double calculateSampleIndex(double const accum,
 	double const sample_index = sample_rate_compensate_ratio * (accum - center_of_env) + position_in_samps;
 	return sample_index;
 }
-float calculateSample(juce::dsp::AudioBlock<float> const wave_block, double const sample_index, float const win, float const velocity_amplitude){
-	assert(wave_block.getNumChannels() > 0);
-	assert(wave_block.getNumSamples() > 0);
-	auto const samp = gen::peek<float,
-						gen::interpolationModes_e::hermite,
-						gen::boundsModes_e::wrap
-						>(wave_block.getChannelPointer(0), sample_index, wave_block.getNumSamples());
-	return win * velocity_amplitude * samp;
-}
 float calculatePan(float pan_latch_val){
 	return memoryless::clamp(pan_latch_val, 0.f, 1.f) * std::numbers::pi * 0.5f;
 }
-void writeAudioToOuts(float const sample, float const pan_latch_val, GrainwisePostProcessing &postProcessing, Grain::outs &outs){
-	std::array<float, 2> const lr = postProcessing(gen::pol2car(sample, pan_latch_val));
-	outs.audio_L = lr[0];
-	outs.audio_R = lr[1];
-}
-void processBusyness(float const window, nvs::gen::history<float> &busyHistory, Grain::outs &outs){
-	float const  busy_tmp = (window > 0.f);
-	outs.busy = busy_tmp;
-	busyHistory(busy_tmp);
-}
 }	// end anonymous namespace
 
 void Grain::setReadBounds(ReadBounds newReadBounds){
 	_upcoming_normalized_read_bounds = newReadBounds;
 }
-void Grain::resetAccum() {
-	_accum.reset();
-}
-void Grain::setAccum(float newVal) {
-	_accum.set(newVal);
-}
 float GrainwisePostProcessing::operator()(float x){
-	float retval {0.f};
+	return shape(x, drive, makeup_gain);
+}
+float GrainwisePostProcessing::shape(float x, float const drive, float const makeup_gain){
 	jassert (drive > 0);
-	x *= drive;
-	retval = (2.f * x) / (1.f + std::sqrt(1.f + std::abs(x)));
-	retval /= (2.f * drive) / (1.f + std::sqrt(1.f + std::abs(drive)));
 	jassert(makeup_gain > 0.f);
-	retval *= makeup_gain;
-	return retval;
+	return shaper::shape(x, drive, shaper::outputGain(drive, makeup_gain));
+}
+double Grain::latchNormalizedPosition(bool const gate){
+	double np = _position_lgr(gate);
+	auto const scanner_pos = _scanner_for_position_latch(_voice_shared_state->_scanner.phasor_offset(0.f) * _voice_shared_state->_scanner_amount, gate);
+	np = nvs::memoryless::mspWrap(np + scanner_pos);
+	assert (np >= 0.0);
+	assert (np <= 1.0);
+	return np;
 }
-Grain::outs Grain::operator()(float const trig_in){
+std::optional<GrainSpawn> Grain::spawn(float const rampPhase){
 	assert(_synth_shared_state);
-	juce::dsp::AudioBlock<float> const wave_block = _synth_shared_state->_buffer._wave_block;
 	auto const playback_sr = _synth_shared_state->_playback_sample_rate;
 	auto const file_sr = _synth_shared_state->_buffer._file_sample_rate;
 	auto const& settings = _synth_shared_state->_settings;
+	bool constexpr open = true;
 	
-	outs o;
-	o.next = _busy_histo.val ? trig_in : 0.f;
-	
-	bool const should_open_latches = _busy_histo.val ? false : static_cast<bool>(trig_in);
-
-	
-	_waveform_read_rate = calculateTransposeMultiplier(_ratio_for_note_latch(_ratio_based_on_note, should_open_latches),
-													   fastSemitonesToRatio(_transpose_lgr(should_open_latches)));
-	_accum(_waveform_read_rate, static_cast<bool>(should_open_latches));
-	
-	double const file_sample_rate_compensate_ratio = calculateSampleReadRate(playback_sr, file_sr);
-
-	if (should_open_latches){
-		_normalized_read_bounds = _upcoming_normalized_read_bounds;
-		_postProcessing.drive = _grain_drive;
-		_postProcessing.makeup_gain = _grain_makeup_gain;
-
 #if GRAIN_UPDATE_HACK
-		if (wantsToDisableFirstPlaythroughOfVoicesNote){
-			firstPlaythroughOfVoicesNote = false;
-			wantsToDisableFirstPlaythroughOfVoicesNote = false;
-		}
-		wantsToDisableFirstPlaythroughOfVoicesNote = true;
-#endif
+	if (wantsToDisableFirstPlaythroughOfVoicesNote){
+		firstPlaythroughOfVoicesNote = false;
+		wantsToDisableFirstPlaythroughOfVoicesNote = false;
 	}
+	wantsToDisableFirstPlaythroughOfVoicesNote = true;
+#endif
+	// the ramped parameters take their value at the onset
+	auto const &params = _synth_shared_state->_params;
+	_position_lgr.setMu(params.position.at(rampPhase));
+	_grain_drive = params.fx_grain_drive.at(rampPhase);
+	_grain_makeup_gain = params.fx_makeup_gain.at(rampPhase);
 	
-	
+	// the order in which latches open fixes how random numbers are consumed
+	_normalized_read_bounds = _upcoming_normalized_read_bounds;
+	float const waveform_read_rate = calculateTransposeMultiplier(_ratio_for_note_latch(_ratio_based_on_note, open),
+													   fastSemitonesToRatio(_transpose_lgr(open)));
 	if (_normalized_read_bounds.end - _normalized_read_bounds.begin == 0.0){	// protection for initialization case
-		_window = 0.f;
-		writeAudioToOuts(0.f, 0.f, _postProcessing, o);
-		processBusyness(_window, _busy_histo, o);
-		return o;
-	}
-	
-	auto const buffLength = _synth_shared_state->_buffer._wave_block.getNumSamples();
-	ReadBounds denormedReadBounds = _normalized_read_bounds * static_cast<double>(buffLength);
-	if (denormedReadBounds.end < denormedReadBounds.begin){
-		denormedReadBounds.end += buffLength;	// now this can be longer than the actual number of samples in the buffer. should be taken care of by wrapping in peek().
-		assert (denormedReadBounds.end > denormedReadBounds.begin);
+		return std::nullopt;
 	}
-
-	size_t const compensatedLength = [&settings, &denormedReadBounds, buffLength, file_sample_rate_compensate_ratio](){
-		float const dur_dep_on_read_bounds = settings._duration_dependence_on_read_bounds;
-		size_t const event_length = denormedReadBounds.end - denormedReadBounds.begin;
-		size_t const cLen = static_cast<size_t>(nvs::memoryless::linterp((float)buffLength, (float)event_length, dur_dep_on_read_bounds) / file_sample_rate_compensate_ratio);
-		assert (0 < cLen);
-		return cLen;
-	}();
-
-	double const duration_in_samps = calculateDurationInSamples(_duration_ler(should_open_latches), compensatedLength,
-																playback_sr);	// take settings._center_position_at_env_peak as param to determine if it should clip normalized duration to 0-1?
-	assert (duration_in_samps <= compensatedLength);
-	float const latch_skew_result = memoryless::clamp(_skew_lgr(should_open_latches), 0.001f, 0.999f);
-	
-	float const duration_pitch_compensation_factor = getDurationPitchCompensationFactor(settings._duration_pitch_compensation, _waveform_read_rate);
-//#ifdef DBG
-//	_timed_printer->print("duration_pitch_compensation_factor: {}", duration_pitch_compensation_factor);
-//#endif
-	double norm_pos = [this, should_open_latches](){
-		double np = _position_lgr(should_open_latches);
-		auto const scanner_pos = _scanner_for_position_latch(_voice_shared_state->_scanner.phasor_offset(0.f) * _voice_shared_state->_scanner_amount, should_open_latches);
-		np = nvs::memoryless::mspWrap(np + scanner_pos);
-		assert (np >= 0.0);
-		assert (np <= 1.0);
-		return np;
-	}();
-	
-	_window = calculateWindow(_accum.val,							// double const accum
-							  duration_in_samps,					// double const duration
-							  duration_pitch_compensation_factor,	// float const transpositionMultiplier
-							  latch_skew_result,					// float const skew
-							  _plateau_lgr(should_open_latches));	// float plateau
-#if GRAIN_UPDATE_HACK
-	if (firstPlaythroughOfVoicesNote){
-		writeAudioToOuts(0.f, 0.f, o);
-		processBusyness(_window, _busy_histo, o);
-		return o;
-	}
-#endif
-
-	_sample_index = [this, norm_pos, duration_in_samps, latch_skew_result, duration_pitch_compensation_factor, file_sample_rate_compensate_ratio, &settings, &denormedReadBounds](){
-		// double const normalized_position, double const sr_compensated_duration, float const skew, float const sample_playback_rate, bool const center_envelope_at_env_peak
-		auto const center_of_env = calculateCenterOfEnvelope(norm_pos,														// double const normalized_position
-															 duration_in_samps,												// double const sr_compensated_duration
-															 latch_skew_result,												// float const skew
-															 duration_pitch_compensation_factor,							// float const sample_playback_rate
-															 settings._center_position_at_env_peak);	// bool const center_envelope_at_env_peak
-				
-		return calculateSampleIndex(_accum.val,							// double const accum
-							 norm_pos,									// double const normalized_position
-							 denormedReadBounds.begin, 					// double const sample_left_bound
-							 denormedReadBounds.end,					// double const sample_right_bound
-							 file_sample_rate_compensate_ratio,			// double const sample_rate_compensate_ratio
-							 center_of_env);							// double const center_of_env
-	}();
+	double const file_sample_rate_compensate_ratio = calculateSampleReadRate(playback_sr, file_sr);
+	auto const buffLength = _synth_shared_state->_buffer._frames.getLength();
+	ReadBounds const denormedReadBounds = denormalizeReadBounds(_normalized_read_bounds, buffLength);
+	size_t const compensatedLength = calculateCompensatedLength(settings._duration_dependence_on_read_bounds, denormedReadBounds,
+																buffLength, file_sample_rate_compensate_ratio);
+	double const duration_in_samps = calculateDurationInSamples(_duration_ler(open), compensatedLength, playback_sr);
+	float const latch_skew_result = memoryless::clamp(_skew_lgr(open), 0.001f, 0.999f);
+	float const duration_pitch_compensation_factor = getDurationPitchCompensationFactor(settings._duration_pitch_compensation, waveform_read_rate);
+	double const norm_pos = latchNormalizedPosition(open);
+	float const plateau = _plateau_lgr(open);
 	
-
-	float const sample = [&](){
-		float const vel_amplitude = _amplitude_for_note_latch(_amplitude_based_on_note, should_open_latches)
+	auto const center_of_env = calculateCenterOfEnvelope(norm_pos, duration_in_samps, latch_skew_result,
+														 duration_pitch_compensation_factor, settings._center_position_at_env_peak);
+	float const vel_amplitude = _amplitude_for_note_latch(_amplitude_based_on_note, open)
 #ifdef TSN
-								* _grain_weight_latch(_grain_weight, should_open_latches);
+								* _grain_weight_latch(_grain_weight, open);
 #endif
-		;
-		return calculateSample(wave_block, _sample_index, _window, vel_amplitude);
-	}();
-	_pan = calculatePan(_pan_lgr(should_open_latches));
+	;
+	float const pan = calculatePan(_pan_lgr(open));
+	auto const gains = panGains(settings._pan_law, pan);
 	
-	writeAudioToOuts(sample, _pan, _postProcessing, o);
-	
-	processBusyness(_window, _busy_histo, o);
-	
-	if (nvs::util::checkNanOrInf(std::array<float, 2>{o.audio_L, o.audio_R})){
-		return {};
-	}
-	
-	return o;
+	return GrainSpawn {
+		.read_rate = waveform_read_rate,
+		.window_length = duration_in_samps * duration_pitch_compensation_factor,
+		.index_origin = calculateSampleIndex(0.0, norm_pos, denormedReadBounds.begin, denormedReadBounds.end,
+											 file_sample_rate_compensate_ratio, center_of_env),
+		.index_rate = file_sample_rate_compensate_ratio,
+		.skew = latch_skew_result,
+		.plateau = plateau,
+#if GRAIN_UPDATE_HACK
+		.amplitude = firstPlaythroughOfVoicesNote ? 0.f : vel_amplitude,
+#else
+		.amplitude = vel_amplitude,
+#endif
+		.pan = pan,
+		.gain_L = gains.L,
+		.gain_R = gains.R,
+		.drive = _grain_drive,
+		.makeup_gain = _grain_makeup_gain,
+		.shaper_gain = shaper::outputGain(_grain_drive, _grain_makeup_gain)
+	};
 }
 }	// namespace nvs::gran
@@ -15,6 +15,13 @@
 #include <JuceHeader.h>
 
 #include "GrainDescription.h"
+#include "GrainSpawn.h"
+#include "GrainWindow.h"
+#include "GrainPool.h"
+#include "GrainScheduler.h"
+#include "PanLaw.h"
+#include "ParamSnapshot.h"
+#include "Waveshaper.h"
 #include "VoicesXGrains.h"
 #include "../LatchedRandom.h"
 #include "../misc_util.h"
@@ -55,19 +62,40 @@ using MuSigmaPair_f  = nvs::rand::MuSigmaPair<float>;
 using MuSigmaPair_d  = nvs::rand::MuSigmaPair<double>;
 using BoxMuller = nvs::rand::BoxMuller;
 using ExponentialRandomNumberGenerator = nvs::rand::ExponentialRandomNumberGeneratorWithVariance;
-using LatchedGaussianRandom_f = decltype(createLatchedGaussianRandom(std::declval<BoxMuller&>(), std::declval<MuSigmaPair_f>()));
-using LatchedGaussianRandom_d = decltype(createLatchedGaussianRandom(std::declval<BoxMuller&>(), std::declval<MuSigmaPair_d>()));
-using LatchedExponentialRandom_f = decltype(createLatchedExponentialRandom(std::declval<ExponentialRandomNumberGenerator&>(), std::declval<MuSigmaPair_f>()));
-using LatchedExponentialRandom_d = decltype(createLatchedExponentialRandom(std::declval<ExponentialRandomNumberGenerator&>(), std::declval<MuSigmaPair_d>()));
+using GaussianRNG = nvs::rand::GaussianZiggurat;	// what the voices draw from; BoxMuller and ExponentialRandomNumberGenerator also fit
+using ExponentialRNG = nvs::rand::ExponentialZiggurat;
+using LatchedGaussianRandom_f = decltype(createLatchedGaussianRandom(std::declval<GaussianRNG&>(), std::declval<MuSigmaPair_f>()));
+using LatchedGaussianRandom_d = decltype(createLatchedGaussianRandom(std::declval<GaussianRNG&>(), std::declval<MuSigmaPair_d>()));
+using LatchedExponentialRandom_f = decltype(createLatchedExponentialRandom(std::declval<ExponentialRNG&>(), std::declval<MuSigmaPair_f>()));
+using LatchedExponentialRandom_d = decltype(createLatchedExponentialRandom(std::declval<ExponentialRNG&>(), std::declval<MuSigmaPair_d>()));
+/**
+ Where grains draw their randomness from.
+ perVoice: each voice's generators, in whatever order its grains happen to fire.
+ counterBased: a counter-based stream positioned at (voice, grain, spawn count), so a grain's random parameters do not depend
+ on what any other grain or voice drew before it. The synth then also gives each voice its own partition of the grain pool
+ (see GranularSynthesizer::setRandomStreams), so a render with VoiceRendering::parallel is sample for sample that of a
+ sequential one. VoiceRendering::parallelGrains is not: its threads' partial sums of a voice's grains are added in thread order.
+ */
+enum class RandomStreams {
+	perVoice,
+	counterBased
+};
 //========================================================================================================================================
 struct GranularSynthSharedState {
-	explicit GranularSynthSharedState(juce::AudioProcessorValueTreeState &apvts)	:	_apvts(apvts){}
+	explicit GranularSynthSharedState(juce::AudioProcessorValueTreeState &apvts)	:	_param_reader(apvts), _apvts(apvts){}
 	double _playback_sample_rate {0.0};
 	
+	ParamSnapshotReader _param_reader;
+	ParamSnapshot _params;	// this block's parameter values; refreshed by GranularSynthesizer::processBlock before any voice renders
+	
 	struct Buffer {
-		juce::dsp::AudioBlock<float> _wave_block;
+		SourceBuffer _frames;	// the loaded sample, interleaved
 		double _file_sample_rate {0.0};
 		size_t _filename_hash;
+		std::unique_ptr<SourcePyramid> _octaves;	// _frames' octave-decimated copies; null until built off the audio thread
+		SourceLevels levels() const {
+			return {_frames.view(), _octaves.get()};
+		}
 	};
 	Buffer _buffer;
 	
@@ -77,18 +105,40 @@ struct GranularSynthSharedState {
 		bool _center_position_at_env_peak { true };
 		float _duration_pitch_compensation { 1.f };
 		float _duration_dependence_on_read_bounds { 0.95f };// at 0, the 'duration' parameter is a fraction of the whole file; at 1, it is a fraction of the current event within the file.
+		PanLaw _pan_law { PanLaw::equalPower };
+		int _num_voices { N_VOICES };	// what the synth is currently built with; changed only through GranularSynthesizer::setVoiceAndGrainCounts
+		size_t _grains_per_voice { N_GRAINS };
+		RandomStreams _random_streams { RandomStreams::perVoice };
+		std::uint64_t _random_seed { 1234567890UL };	// the counter-based streams' key, shared by every voice
 	};
 	Settings _settings;
 	
+	struct NonFiniteReport {	// written by the voices on the audio thread, read by anyone
+		std::atomic<std::uint32_t> _blocks {0};	// voice blocks zeroed because they held NaN or Inf
+		std::atomic<int> _last_voice {-1};
+	};
+	NonFiniteReport _non_finite;
+	
+	GrainWindowTable const _window_table;	// built once with the synth, shared by every grain
+	GrainPool _grain_pool {N_VOICES * N_GRAINS, _window_table};	// voices borrow their sounding grains from here
+	
 	juce::AudioProcessorValueTreeState& _apvts;
 };
 
 struct GranularVoiceSharedState {
 	// random generators are uniquely seeded per voice.
-	BoxMuller _gaussian_rng;
-	ExponentialRandomNumberGenerator _expo_rng;
+	GaussianRNG _gaussian_rng;
+	ExponentialRNG _expo_rng;
+	nvs::rand::PhiloxStream _counter_rng;	// only drawn from with RandomStreams::counterBased
 	int _voice_id;
 	
+	void selectRandomStreams(GranularSynthSharedState::Settings const &settings){
+		bool const counterBased = (settings._random_streams == RandomStreams::counterBased);
+		_counter_rng.setSeed(settings._random_seed);
+		_gaussian_rng.setCounterStream(counterBased ? &_counter_rng : nullptr);
+		_expo_rng.setCounterStream(counterBased ? &_counter_rng : nullptr);
+	}
+	
 	float trigger;
 	
 	nvs::lfo::simple_lfo<float> _scanner;
@@ -110,6 +160,7 @@ struct ReadBounds {
 struct GrainwisePostProcessing
 {
 	float operator()(float x);	// single channel
+	static float shape(float x, float drive, float makeup_gain);	// resolves the normalization per call; the renderers cache it in GrainSpawn::shaper_gain
 	
 	std::array<float, 2> operator()(std::array<float, 2> x){	// apply single to both channels
 		std::array<float, 2> retval {0.f, 0.f};
@@ -130,8 +181,8 @@ public:
 	//====================================================================================
 	void setSampleRate(double sampleRate);
 	//====================================================================================
-	static constexpr size_t getNumGrains(){
-		return N_GRAINS;
+	size_t getNumGrains() const {	// spawners per voice; sounding grains are borrowed from the synth's GrainPool
+		return _grains.size();
 	}
 	inline void noteOn(const noteNumber_t note, const velocity_t velocity){	// reassign to noteHolder
 		doNoteOn(note, velocity);
@@ -145,13 +196,23 @@ public:
 	inline void clearNotes(){
 		doClearNotes();
 	}
-	inline void shuffleIndices(){
-		doShuffleIndices();
-	}
 	void setGrainsIdle();
 	std::vector<float> getBusyStatuses() const;
+	void setRampPosition(int sampleInBlock){	// where in the synth block the next rendered sample falls; places onsets on the snapshot's ramps
+		_ramp_position = sampleInBlock;
+	}
 	//=======================================================================
 	std::array<float, 2> operator()(float triggerIn);
+	/**
+	 Renders numSamples of stereo output into outL/outR (overwriting them).
+	 Onsets are scheduled ahead for the whole block and grains are rendered span-wise between them, so the trigger routing only
+	 runs when a trigger actually fires.
+	 Grains sound on slots of the synth-wide GrainPool, so the voice is not limited to getNumGrains() of them; only the pool's
+	 total budget is fixed. The output is scaled by 1 / sqrt of the voice's share of that budget (its partition's size, see
+	 GrainPool::getPartitionSize), so it stays in range with every slot it may borrow sounding; with one partition that is
+	 the whole pool, which puts a voice 10 log10(number of voices) dB below scaling by getNumGrains() (9 dB with 8 voices).
+	 */
+	void processBlock(float *outL, float *outR, int numSamples);
 	void setReadBounds(ReadBounds newReadBounds) ;
 	struct WeightedReadBounds {
 		ReadBounds bounds;
@@ -159,7 +220,15 @@ public:
 		WeightedReadBounds(ReadBounds b, double w)	:	bounds(b), weight(w) {}
 	};
 	void setMultiReadBounds(std::vector<WeightedReadBounds> newReadBounds) ;
-	std::vector<GrainDescription> getGrainDescriptions() const;
+	/**
+	 Replaces the contents of descriptions with one entry per spawner, so that each (voice, grain) pair appears once: the loudest
+	 grain it has sounding on the pool, or a silent entry if none. Never allocates once descriptions has reserved
+	 getMaxNumGrainDescriptions().
+	 */
+	void getGrainDescriptions(std::vector<GrainDescription> &descriptions) const;
+	std::size_t getMaxNumGrainDescriptions() const {
+		return _grains.size();
+	}
 	void setLogger(std::function<void(const juce::String&)> loggerFunction);
 	
 	void setParams();
@@ -169,29 +238,44 @@ protected:
 	virtual void doNoteOff(noteNumber_t note);						// remove from noteHolder
 	virtual void doUpdateNotes(/*enum noteDistribution_t?*/);
 	virtual void doClearNotes();
-	virtual void doShuffleIndices();
 
 	std::array<float, 2> doProcess(float triggerIn);
 	
+	void renderScheduled(float *outL, float *outR, int numSamples);	// numSamples <= GrainScheduler::maxBlockSize
+	void advanceScanner(int numSamples);
+	void startGrain(int sampleInBlock);
+	void seekRandomStream(std::uint32_t stream, std::uint32_t event);	// no-op unless RandomStreams::counterBased
+	void renderGrains(float *outL, float *outR, int numSamples);
+	void guardNonFinite(float *outL, float *outR, int numSamples);	// zeroes the block and reports the voice if any sample is NaN or Inf
+	void updateNormalizer();	// follows the voice's pool budget, which changes when the pool is repartitioned
+	
 	//================================================================================
 	GranularSynthSharedState *const _synth_shared_state;
 	GranularVoiceSharedState *const _voice_shared_state;
 
-	std::vector<Grain> _grains;
+	std::vector<Grain> _grains;	// spawners: each latches parameters for the grains it starts
+	GrainPool &_pool;
 private:
+	int getOwnerId() const {
+		return _voice_shared_state->_voice_id;
+	}
 	float _normalizer {1.f};
+	std::size_t _normalizer_budget {0};	// the partition size _normalizer was computed for
+	size_t _next_spawner {0};	// spawners take onsets in turn, so that notes and read bounds are shared out evenly
+	static constexpr std::uint32_t schedulerStream {0xffffffffu};	// the counter-based stream the onset times draw from; spawners use their ids
+	std::uint32_t _onset_count {0};
+	int _ramp_position {0};
 
-    std::vector<size_t> _grain_indices;	// used to index grains in random order
-    gen::phasor<double> _phasor_internal_trig;
-
+	GrainScheduler _scheduler;
 	LatchedExponentialRandom_d _speed_ler; /*{_expo_rng, {1.f, 0.f}};*/
     
-    nvs::gen::history<float> _trigger_histo;
-    nvs::gen::ramp2trig<float> _ramp2trig;
-    
     NoteHolder _note_holder {};
 };
 
+/**
+ A grain's parameter side: its latches and latched randoms, which resolve into a GrainSpawn each time it starts a grain.
+ The sound itself is rendered by whichever GrainPool slot the spawn is started on.
+ */
 class Grain {
 public:
 	explicit Grain(GranularSynthSharedState *synth_shared_state,
@@ -199,27 +283,23 @@ public:
 					   int newId = -1);
 	
 	void setId(int newId);
-	void resetAccum();
-	void setAccum(float newVal);
+	int getId() const { return _grain_id; }
 	void setRatioBasedOnNote(float ratioForNote);
 	void setAmplitudeBasedOnNote(float velocity);
 	
-	float getBusyStatus() const;
-	void setBusyStatus(bool newBusyStatus);
-	struct outs {
-		float next 		{0.f};
-		float busy 		{0.f};
-		float audio_L	{0.f};
-		float audio_R 	{0.f};
-	};
-	
 	void setReadBounds(ReadBounds newReadBounds);
 	void setWeight(double w) {
 		_grain_weight = w;
 	}
-	outs operator()(float trig_in);
-	
-	GrainDescription getGrainDescription() const;
+	/**
+	 Opens every latch and resolves the grain's lifetime constants.
+	 rampPhase places the onset within the synth block (0 to 1), for the parameters the snapshot ramps.
+	 Returns nullopt if the grain cannot play (no read bounds yet).
+	 */
+	std::optional<GrainSpawn> spawn(float rampPhase = 1.f);
+	std::uint32_t nextSpawnCount(){	// keys this spawner's counter-based random stream
+		return _spawn_count++;
+	}
 	
 	void setFirstPlaythroughOfVoicesNote(bool isFirstPlaythrough){
 		firstPlaythroughOfVoicesNote = isFirstPlaythrough;
@@ -229,6 +309,8 @@ private:
 	GranularSynthSharedState *const _synth_shared_state;
 	GranularVoiceSharedState *const _voice_shared_state;
 	
+	double latchNormalizedPosition(bool gate);
+	
 	void writeToLog(const juce::String &s){
 		assert(_synth_shared_state != nullptr);
 		_synth_shared_state->_logger_func(s);
@@ -239,13 +321,12 @@ private:
 //#endif
 	
 	int _grain_id;
+	std::uint32_t _spawn_count {0};
 	
 	// this is hacky and would be better implemented as a sort of latch as well
 	bool wantsToDisableFirstPlaythroughOfVoicesNote {false};	// the signal to turn firstPlaythroughOfVoicesNote off
 	bool firstPlaythroughOfVoicesNote { true };// the signal indicating that the currently set parameters, via latches/latched randoms, are invalid and thus the grain should be muted
 	
-	
-    nvs::gen::history<float> _busy_histo; // history of 'busy' boolean signal, goes to [switch 1 2]
     nvs::gen::latch<float> _ratio_for_note_latch {1.f};
     nvs::gen::latch<float> _amplitude_for_note_latch {0.f};
 	nvs::gen::latch<float> _scanner_for_position_latch {0.f};
@@ -258,18 +339,9 @@ private:
 	LatchedGaussianRandom_f 	_plateau_lgr;
 	LatchedGaussianRandom_f 	_pan_lgr;
     
-    nvs::gen::accum<double> _accum; // accumulates samplewise and resets from gate on, goes to windowing and sample lookup!
-    
 	ReadBounds _normalized_read_bounds;// defaults to normalized read bounds. TSN variant can adjust effective read bounds (changing begin and end based on event positions/durations).
 	ReadBounds _upcoming_normalized_read_bounds;
 	
-	GrainwisePostProcessing _postProcessing;
-	
-	// these get used both for operator() as well as passing on to gui via getGrainDescription
-    double _sample_index {0.0};
-    float _waveform_read_rate {0.0};
-    float _window {0.f};
-	float _pan {0.f};
 	float _grain_weight {1.f};
     
     float _ratio_based_on_note {1.f}; // =1.f. later this may change according to a settable concert pitch
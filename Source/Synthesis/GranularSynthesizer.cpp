@@ -26,25 +26,113 @@ void GranularSynthesizer::initializeVoices() {
     clearVoices();
     unsigned long seed = 1234567890UL;
     totalNumGrains_ = 0;
-    for (int i = 0; i < num_voices; ++i) {
+    for (int i = 0; i < _synth_shared_state._settings._num_voices; ++i) {
         const auto voice = GranularVoice::create<nvs::gran::PolyGrain>(&_synth_shared_state, seed, i);
         addVoice(voice);
-        totalNumGrains_ += GranularVoice::getNumGrains();
+        totalNumGrains_ += voice->getNumGrains();
         ++seed;
     }
     // previously, addSound occurred here
     setCurrentPlaybackSampleRate(getSampleRate());	// if voices' sample rates need updating, this shall do it
 }
+void GranularSynthesizer::setVoiceAndGrainCounts(int numVoices, int grainsPerVoice) {
+    numVoices = std::clamp(numVoices, 1, MAX_VOICES);
+    auto const numGrains = static_cast<size_t>(std::clamp(grainsPerVoice, 1, static_cast<int>(MAX_GRAINS)));
+    auto &settings = _synth_shared_state._settings;
+    if ((numVoices == settings._num_voices) && (numGrains == settings._grains_per_voice)) {
+        return;
+    }
+    const juce::ScopedLock sl (lock);
+    settings._num_voices = numVoices;
+    settings._grains_per_voice = numGrains;
+    _synth_shared_state._grain_pool.setCapacity(static_cast<size_t>(numVoices) * numGrains);
+    updatePartitions();
+    initializeVoices();
+    if (!_voice_buffers.empty()) {
+        _voice_buffers.resize(static_cast<size_t>(numVoices), _voice_buffers.front());	// rendering in parallel: one per voice, as long
+    }
+}
+void GranularSynthesizer::setRandomStreams(RandomStreams streams, std::uint64_t seed) {
+    const juce::ScopedLock sl (lock);
+    _synth_shared_state._settings._random_streams = streams;
+    _synth_shared_state._settings._random_seed = seed;
+    updatePartitions();
+}
+void GranularSynthesizer::updatePartitions() {
+    // one per voice when voices render concurrently, so workers never share slots; and with counter-based streams, so that a
+    // full pool drops the same onsets however the voices are rendered
+    bool const perVoice = (_voice_rendering == VoiceRendering::parallel)
+                        || (_synth_shared_state._settings._random_streams == RandomStreams::counterBased);
+    auto const numPartitions = perVoice ? static_cast<size_t>(_synth_shared_state._settings._num_voices) : size_t{1};
+    if (numPartitions != _synth_shared_state._grain_pool.getNumPartitions()) {
+        _synth_shared_state._grain_pool.setPartitions(numPartitions);
+    }
+}
+void GranularSynthesizer::setVoiceRendering(VoiceRendering mode, int numWorkers, int maxBlockSize, size_t minParallelGrains) {
+    const juce::ScopedLock sl (lock);
+    auto &pool = _synth_shared_state._grain_pool;
+    pool.setGrainWorkers(nullptr);
+    _render_workers.stop();
+    _voice_buffers.clear();
+    // more threads than cores (or, rendering whole voices, than voices) would only wait on one another
+    numWorkers = std::min(numWorkers, juce::SystemStats::getNumCpus() - 1);
+    if (mode == VoiceRendering::parallel) {
+        numWorkers = std::min(numWorkers, getNumVoices() - 1);
+    }
+    if ((mode == VoiceRendering::sequential) || (numWorkers <= 0) || (maxBlockSize <= 0)) {
+        mode = VoiceRendering::sequential;
+    }
+    _voice_rendering = mode;
+    updatePartitions();
+    if (mode == VoiceRendering::sequential) {
+        return;
+    }
+    _render_workers.start(numWorkers);
+    if (mode == VoiceRendering::parallel) {
+        _voice_buffers.resize(static_cast<size_t>(getNumVoices()));
+        for (auto &b : _voice_buffers) {
+            b.setSize(2, maxBlockSize);
+        }
+    }
+    else {
+        pool.setGrainWorkers(&_render_workers, minParallelGrains);
+    }
+}
+void GranularSynthesizer::renderVoices(juce::AudioBuffer<float> &outputAudio, int startSample, int numSamples) {
+    // called by renderNextBlock with the lock held, between MIDI events
+    int const numVoices = static_cast<int>(voices.size());
+    if ((_voice_rendering != VoiceRendering::parallel) || _voice_buffers.empty() || (_voice_buffers.size() < static_cast<size_t>(numVoices))
+        || (startSample + numSamples > _voice_buffers.front().getNumSamples())) {
+        Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+        return;
+    }
+    int const numThreads = _render_workers.getNumThreads();
+    // voices render at the same offset into their own buffer as into the output, so parameter ramps line up
+    auto job = [&](int const thread) {
+        for (int v = thread; v < numVoices; v += numThreads) {
+            auto &buffer = _voice_buffers[static_cast<size_t>(v)];
+            buffer.clear(startSample, numSamples);
+            voices[v]->renderNextBlock(buffer, startSample, numSamples);
+        }
+    };
+    _render_workers.run(job);
+
+    // added in voice order, as Synthesiser::renderVoices adds them, so the sums round as they do rendering sequentially
+    int const numChannels = std::min(outputAudio.getNumChannels(), 2);
+    for (int v = 0; v < numVoices; ++v) {
+        for (int ch = 0; ch < numChannels; ++ch) {
+            outputAudio.addFrom(ch, startSample, _voice_buffers[static_cast<size_t>(v)], ch, startSample, numSamples);
+        }
+    }
+}
 std::vector<nvs::gran::GrainDescription> GranularSynthesizer::getGrainDescriptions() const {
     std::vector<nvs::gran::GrainDescription> grainDescriptions;
     grainDescriptions.reserve(totalNumGrains_);
 
     for (const auto &v : voices) {
         if (GranularVoice const *const gv = dynamic_cast<GranularVoice *const>(v)){
-            std::vector<nvs::gran::GrainDescription> const theseDescriptions = gv->getGrainDescriptions();
-            for (const auto &desc : theseDescriptions) {
-                grainDescriptions.push_back(desc);
-            }
+            auto const &theseDescriptions = gv->getGrainDescriptions();
+            grainDescriptions.insert(grainDescriptions.end(), theseDescriptions.begin(), theseDescriptions.end());
         }
         else {
             jassert(false);
@@ -55,9 +143,26 @@ std::vector<nvs::gran::GrainDescription> GranularSynthesizer::getGrainDescriptio
 void GranularSynthesizer::setAudioBuffer(juce::AudioBuffer<float> &waveBuffer, double newFileSampleRate, size_t fileNameHash){
     assert(hasLogger());
     writeToLog(" setAudioBuffer");
-    _synth_shared_state._buffer._wave_block = juce::dsp::AudioBlock<float>(waveBuffer);
-    _synth_shared_state._buffer._file_sample_rate = newFileSampleRate;
-    _synth_shared_state._buffer._filename_hash = fileNameHash;
+    _octave_builder.cancel();	// before taking the lock, which a finishing build also takes
+    SourceBuffer frames (waveBuffer);	// copied and interleaved before taking the lock, and the old frames freed after it
+    std::unique_ptr<SourcePyramid> stale;
+    {
+        const juce::ScopedLock sl (lock);
+        std::swap(_synth_shared_state._buffer._frames, frames);
+        _synth_shared_state._buffer._file_sample_rate = newFileSampleRate;
+        _synth_shared_state._buffer._filename_hash = fileNameHash;
+        stale = std::move(_synth_shared_state._buffer._octaves);
+        _synth_shared_state._grain_pool.retarget(_synth_shared_state._buffer.levels());	// off the frames freed below
+    }
+    _octave_builder.build(_synth_shared_state._buffer._frames.view());
+}
+void GranularSynthesizer::installOctaves(std::unique_ptr<SourcePyramid> octaves) {
+    {   // called on the builder's thread; renderNextBlock holds the lock, so no voice is reading the octaves being replaced
+        const juce::ScopedLock sl (lock);
+        std::swap(_synth_shared_state._buffer._octaves, octaves);
+        _synth_shared_state._grain_pool.retarget(_synth_shared_state._buffer.levels());	// grains latched onto the old octaves
+    }
+    // the previous octaves (if any) are freed here, outside the lock
 }
 
 void GranularSynthesizer::setCurrentPlaybackSampleRate(double newSampleRate) {
@@ -11,6 +11,8 @@
 #pragma once
 #include <JuceHeader.h>
 #include "./GranularVoice.h"
+#include "./RenderWorkers.h"
+#include "./SourcePyramid.h"
 
 namespace nvs::gran {
 class GranularSynthesizer
@@ -21,16 +23,49 @@ class GranularSynthesizer
 {
 public:
     explicit GranularSynthesizer(juce::AudioProcessorValueTreeState &apvts);
+    /**
+     Grains read an interleaved copy of waveBuffer (stereo, or folded down to it) at once; its octave-decimated copies, for reading
+     at high transpositions, follow when a background thread has built them. Not from the audio thread: it waits for any earlier
+     build to stop.
+     */
     void setAudioBuffer(juce::AudioBuffer<float> &waveBuffer, double newFileSampleRate, size_t fileNameHash);
 
     virtual void processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midi)
     {
         // wrapper around renderNextBlock that should also manage any synth-global necessities (because otherwise we must take care
         // of DSP voicewise-only, since renderNextBlock is not virtual and it accumulates samples voicewise)
+        _synth_shared_state._param_reader.read(_synth_shared_state._params, buffer.getNumSamples());	// once per block, for every voice and grain
         renderNextBlock(buffer, midi, 0, buffer.getNumSamples());
     }
-    static constexpr int getNumVoices(){ return num_voices; }
+    /**
+     Rebuilds the voices and the grain pool if the counts differ from the current ones (clamped to MAX_VOICES / MAX_GRAINS).
+     This allocates, so call it from prepareToPlay, never while rendering.
+     */
+    void setVoiceAndGrainCounts(int numVoices, int grainsPerVoice);
+    enum class VoiceRendering {
+        sequential = 0,	// every voice on the audio thread, borrowing from one shared grain pool (see setRandomStreams)
+        parallel = 1,	// voices spread over the audio thread and numWorkers real-time workers, each with its own pool partition
+        parallelGrains = 2	// voices in turn, but a voice with at least minParallelGrains sounding spreads its grains over the workers
+    };
+    /**
+     Selects how voices are rendered, starting or stopping the worker threads and re-partitioning the grain pool to match.
+     Like setVoiceAndGrainCounts, this allocates: call it from prepareToPlay, after the counts are set.
+     */
+    void setVoiceRendering(VoiceRendering mode, int numWorkers, int maxBlockSize,
+                           size_t minParallelGrains = GrainPool::defaultMinParallelGrains);
+    VoiceRendering getVoiceRendering() const {
+        return _voice_rendering;
+    }
+    size_t getNumGrainsPerVoice() const {
+        return _synth_shared_state._settings._grains_per_voice;
+    }
     std::vector<nvs::gran::GrainDescription> getGrainDescriptions() const;
+    std::uint32_t getNumNonFiniteBlocks() const {	// voice blocks zeroed for NaN/Inf since construction; safe to read from the UI
+        return _synth_shared_state._non_finite._blocks.load(std::memory_order_relaxed);
+    }
+    int getLastNonFiniteVoice() const {	// -1 if there has been none
+        return _synth_shared_state._non_finite._last_voice.load(std::memory_order_relaxed);
+    }
     void setCurrentPlaybackSampleRate(double newSampleRate) override;
 
     enum class PositionAlignmentSetting {
@@ -41,6 +76,30 @@ public:
         _synth_shared_state._settings._center_position_at_env_peak = static_cast<bool>(setting);
     }
 
+    void setPanLaw(PanLaw law) {
+        _synth_shared_state._settings._pan_law = law;
+    }
+    /**
+     Voices pick up the streams at their next block. With RandomStreams::counterBased the grain pool is given a partition per
+     voice whatever the VoiceRendering, so that which onsets a full pool drops depends only on the voice's own grains: a sequential
+     and a parallel render are then sample for sample identical. Changing the partitioning allocates and releases every grain,
+     so like setVoiceRendering, call it from prepareToPlay.
+     */
+    void setRandomStreams(RandomStreams streams, std::uint64_t seed = 1234567890UL);
+
+    void setGrainEngine(GrainEngine engine) {
+        _synth_shared_state._grain_pool.setEngine(engine);
+    }
+    void setGrainAllocation(GrainAllocation allocation) {
+        _synth_shared_state._grain_pool.setAllocation(allocation);
+    }
+    void setGrainPrecision(GrainPrecision precision) {
+        _synth_shared_state._grain_pool.setPrecision(precision);
+    }
+    void setInterpolation(interp::Quality quality) {	// takes effect from the next block
+        _synth_shared_state._grain_pool.setInterpolation(quality);
+    }
+
     void setLogger(std::function<void(const juce::String&)> loggerFunction);
     bool hasLogger() const {
         return _synth_shared_state._logger_func != nullptr;
@@ -49,10 +108,16 @@ public:
         return _synth_shared_state;
     }
 protected:
-    constexpr static int num_voices = N_VOICES;
     nvs::gran::GranularSynthSharedState _synth_shared_state;
+    void renderVoices(juce::AudioBuffer<float> &outputAudio, int startSample, int numSamples) override;
 private:
     void initializeVoices();
+    VoiceRendering _voice_rendering {VoiceRendering::sequential};
+    RenderWorkerPool _render_workers;
+    std::vector<juce::AudioBuffer<float>> _voice_buffers;	// one per voice, summed into the output in voice order after each block
+    void updatePartitions();
+    void installOctaves(std::unique_ptr<SourcePyramid> octaves);
+    SourcePyramidBuilder _octave_builder {[this](std::unique_ptr<SourcePyramid> octaves){ installOctaves(std::move(octaves)); }};	// last, so it stops first
     size_t totalNumGrains_;
     //==============================================================================================================
     void writeToLog(const juce::String &s){
@@ -33,7 +33,8 @@ void GranularVoice::setCurrentPlaybackSampleRate(double sampleRate){
 }
 void GranularVoice::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused(samplesPerBlock);
+    _render_buffer.setSize(2, std::max(samplesPerBlock, 1));
+    _grainDescriptions.reserve(granularSynthGuts->getMaxNumGrainDescriptions());
     setCurrentPlaybackSampleRate(sampleRate);
 }
 void GranularVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound *sound, int currentPitchWheelPosition)
@@ -50,12 +51,12 @@ void GranularVoice::startNote (int midiNoteNumber, float velocity, juce::Synthes
     }
 
     {
-        auto &apvts = _synth_shared_state->_apvts;
+        auto const &params = _synth_shared_state->_params;
         adsr.setParameters(juce::ADSR::Parameters (
-            (float)*apvts.getRawParameterValue("amp_env_attack"),
-            (float)*apvts.getRawParameterValue("amp_env_decay"),
-            (float)*apvts.getRawParameterValue("amp_env_sustain"),
-            (float)*apvts.getRawParameterValue("amp_env_release")
+            params.amp_env_attack,
+            params.amp_env_decay,
+            params.amp_env_sustain,
+            params.amp_env_release
         ));
     }
 
@@ -79,7 +80,7 @@ void GranularVoice::stopNote (float velocity, bool allowTailOff)
 bool GranularVoice::isVoiceActive() const {
     return adsr.isActive();
 }
-std::vector<nvs::gran::GrainDescription> GranularVoice::getGrainDescriptions() const {
+std::vector<nvs::gran::GrainDescription> const &GranularVoice::getGrainDescriptions() const {
     return _grainDescriptions;
 }
 void GranularVoice::renderNextBlock (juce::AudioBuffer< float > &outputBuffer, int startSample, int numSamples)
@@ -89,7 +90,7 @@ void GranularVoice::renderNextBlock (juce::AudioBuffer< float > &outputBuffer, i
         granularSynthGuts->noteOff(lastMidiNoteNumber);
         granularSynthGuts->setGrainsIdle();
 
-        _grainDescriptions = granularSynthGuts->getGrainDescriptions();
+        granularSynthGuts->getGrainDescriptions(_grainDescriptions);
         for (auto &gd : _grainDescriptions) {
             gd.window = 0.f;
         }
@@ -97,28 +98,32 @@ void GranularVoice::renderNextBlock (juce::AudioBuffer< float > &outputBuffer, i
     }
     granularSynthGuts->setParams();
 
-    auto totalNumOutputChannels = outputBuffer.getNumChannels();
+    auto const numOutputChannels = std::min(outputBuffer.getNumChannels(), 2);
 
-    double envelope;
-    for (auto samp = startSample; samp < startSample + numSamples; ++samp){
-        envelope = adsr.getNextSample();
-        if (envelope != envelope) {
-            logger("ENVELOPE has NaN");
-        }
-        envelope *= envelope;
-
-        std::array<float, 2> output = (*granularSynthGuts)(0.f /*_voice_shared_state.trigger*/);
-        //		_voice_shared_state.trigger = 0.f;
+    double envelope {0.0};
+    for (int done = 0; done < numSamples; ){
+        int const n = std::min(numSamples - done, _render_buffer.getNumSamples());
+        float *const L = _render_buffer.getWritePointer(0);
+        float *const R = _render_buffer.getWritePointer(1);
+        granularSynthGuts->setRampPosition(startSample + done);
+        granularSynthGuts->processBlock(L, R, n);
 
-        output[0] *= envelope;
-        output[1] *= envelope;
-        for (int channel = 0; channel < totalNumOutputChannels; ++channel) {
-            auto* channelData = outputBuffer.getWritePointer (channel);
-            *(channelData + samp) += output[channel];
+        for (int i = 0; i < n; ++i){
+            envelope = adsr.getNextSample();
+            if (envelope != envelope) {
+                logger("ENVELOPE has NaN");
+            }
+            envelope *= envelope;
+            L[i] *= envelope;
+            R[i] *= envelope;
+        }
+        for (int channel = 0; channel < numOutputChannels; ++channel) {
+            outputBuffer.addFrom(channel, startSample + done, _render_buffer, channel, 0, n);
         }
+        done += n;
     }
-    // query grains for descriptions
-    _grainDescriptions = granularSynthGuts->getGrainDescriptions();
+    // query grains for descriptions, into storage reserved in prepareToPlay: this may run on a render worker
+    granularSynthGuts->getGrainDescriptions(_grainDescriptions);
     for (auto &gd : _grainDescriptions) {
         gd.window *= envelope;
     }
@@ -41,13 +41,13 @@ public:
     void controllerMoved (int controllerNumber, int newControllerValue) override;
     bool canPlaySound (juce::SynthesiserSound *) override ;
 
-    std::vector<nvs::gran::GrainDescription> getGrainDescriptions() const;
+    std::vector<nvs::gran::GrainDescription> const &getGrainDescriptions() const;	// as of the last renderNextBlock
 
     nvs::gran::PolyGrain* getGranularSynthGuts(){
         return granularSynthGuts.get();
     }
-    static size_t getNumGrains(){
-        return nvs::gran::PolyGrain::getNumGrains();
+    size_t getNumGrains() const {
+        return granularSynthGuts->getNumGrains();
     }
     void setLogger(std::function<void(const juce::String&)> loggerFunction);
 private:
@@ -61,9 +61,12 @@ private:
     std::unique_ptr<nvs::gran::PolyGrain> granularSynthGuts;
 
     int lastMidiNoteNumber {0};
-    std::vector<nvs::gran::GrainDescription> _grainDescriptions;
+    std::vector<nvs::gran::GrainDescription> _grainDescriptions;	// reserved in prepareToPlay, filled in place
     juce::ADSR adsr;
 
+    static constexpr int defaultRenderBlockSize {512};
+    juce::AudioBuffer<float> _render_buffer {2, defaultRenderBlockSize};	// sized in prepareToPlay so rendering never allocates
+
     std::function<void(const juce::String&)> logger = nullptr;
 
     struct dbg_counter {
@@ -0,0 +1,474 @@
+/*
+  ==============================================================================
+
+    Interpolation.cpp
+    Created: 16 Oct 2026 1:05:52pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Interpolation.h"
+#include <JuceHeader.h>
+#include <cmath>
+#include <numbers>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define NVS_INTERP_X86 1
+	#include <immintrin.h>
+	#if defined(__GNUC__) || defined(__clang__)
+		#define NVS_TARGET_AVX2 __attribute__((target("avx2")))
+	#else
+		#define NVS_TARGET_AVX2
+	#endif
+#else
+	#define NVS_INTERP_X86 0
+#endif
+
+namespace nvs::gran::interp {
+
+namespace {
+inline float hermite(float const frac, float const y0, float const y1, float const y2, float const y3){
+	float const c0 = y1;
+	float const c1 = 0.5f * (y2 - y0);
+	float const c2 = y0 - 2.5f * y1 + 2.f * y2 - 0.5f * y3;
+	float const c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+	return ((c3 * frac + c2) * frac + c1) * frac + c0;
+}
+inline std::size_t wrapIndex(long long i, long long const n){
+	i %= n;
+	return static_cast<std::size_t>(i < 0 ? i + n : i);
+}
+inline long long wrapRead(long long const i, long long const n){	// a read position outside [0, n) is rare, and only it is wrapped
+	return ((i >= 0) && (i < n)) ? i : static_cast<long long>(wrapIndex(i, n));
+}
+inline float linear(float const frac, float const y0, float const y1){
+	return y0 + frac * (y1 - y0);
+}
+
+double besselI0(double const x){	// power series; converges quickly for the window's arguments
+	double sum {1.0};
+	double term {1.0};
+	for (int k = 1; k < 64; ++k){
+		double const t = x / (2.0 * k);
+		term *= t * t;
+		sum += term;
+		if (term < sum * 1e-12){
+			break;
+		}
+	}
+	return sum;
+}
+SincTable const sincTableInstance;
+
+inline float sincAt(SincTable const &table, float const *const wave, long long const n, long long const whole, float const frac){
+	constexpr int taps {SincTable::taps};
+	constexpr long long before {taps / 2 - 1};
+	float const position = frac * static_cast<float>(SincTable::numPhases);
+	int const p = std::clamp(static_cast<int>(position), 0, SincTable::numPhases - 1);
+	float const t = position - static_cast<float>(p);
+	float const *const c0 = table.phase(p);
+	float const *const c1 = table.phase(p + 1);
+	assert ((whole >= 0) && (whole < n));	// wrapped by the caller, so every tap lies within the guards
+	float const *const y = wave + (whole - before);
+	float sum {0.f};
+	for (int k = 0; k < taps; ++k){
+		sum += (c0[k] + t * (c1[k] - c0[k])) * y[k];
+	}
+	return sum;
+}
+inline void sincStereoAt(SincTable const &table, float const *const frames, long long const n, long long const whole, float const frac,
+						 float &left, float &right){
+	constexpr int taps {SincTable::taps};
+	constexpr long long before {taps / 2 - 1};
+	float const position = frac * static_cast<float>(SincTable::numPhases);
+	int const p = std::clamp(static_cast<int>(position), 0, SincTable::numPhases - 1);
+	float const t = position - static_cast<float>(p);
+	float const *const c0 = table.phase(p);
+	float const *const c1 = table.phase(p + 1);
+	assert ((whole >= 0) && (whole < n));
+	float const *const y = frames + 2 * (whole - before);
+	float sum_L {0.f};
+	float sum_R {0.f};
+	for (int k = 0; k < taps; ++k){
+		float const c = c0[k] + t * (c1[k] - c0[k]);
+		sum_L += c * y[2 * k];
+		sum_R += c * y[2 * k + 1];
+	}
+	left = sum_L;
+	right = sum_R;
+}
+inline void hermiteStereoAt(float const *const frames, long long const i1, float const frac, float &left, float &right){
+	float const *const y = frames + 2 * i1;	// i1 in [0, n): its neighbours are in the guards at worst
+	left = hermite(frac, y[-2], y[0], y[2], y[4]);
+	right = hermite(frac, y[-1], y[1], y[3], y[5]);
+}
+void hermiteGatherStereoPortable(float const *const frames, std::size_t const numFrames, double const *const indices,
+								 float *const outL, float *const outR, std::size_t const count){
+	auto const n = static_cast<long long>(numFrames);
+	for (std::size_t i = 0; i < count; ++i){
+		double const whole = std::floor(indices[i]);
+		hermiteStereoAt(frames, wrapRead(static_cast<long long>(whole), n), static_cast<float>(indices[i] - whole), outL[i], outR[i]);
+	}
+}
+void hermiteGatherStereoPortable(float const *const frames, std::size_t const numFrames, std::int32_t const *const wholes, float const *const fracs,
+								 float *const outL, float *const outR, std::size_t const count){
+	auto const n = static_cast<long long>(numFrames);
+	for (std::size_t i = 0; i < count; ++i){
+		hermiteStereoAt(frames, wrapRead(wholes[i], n), fracs[i], outL[i], outR[i]);
+	}
+}
+
+#if NVS_INTERP_X86
+NVS_TARGET_AVX2 inline __m256i wrapLow(__m256i const v, __m256i const n){	// v < 0 ? v + n : v
+	return _mm256_add_epi32(v, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), v), n));
+}
+NVS_TARGET_AVX2 inline __m256i wrapHigh(__m256i const v, __m256i const n){	// v >= n ? v - n : v
+	return _mm256_sub_epi32(v, _mm256_andnot_si256(_mm256_cmpgt_epi32(n, v), n));
+}
+NVS_TARGET_AVX2 inline bool allWithin(__m256i const v, __m256i const n){	// every lane in [0, n)
+	__m256i const outside = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), v),
+											_mm256_cmpgt_epi32(v, _mm256_sub_epi32(n, _mm256_set1_epi32(1))));
+	return _mm256_testz_si256(outside, outside) != 0;
+}
+NVS_TARGET_AVX2 inline __m128i wrapWhole(__m256d const whole, __m256d const n, __m256d const inv_n){
+	// into [0, n) in double precision, before narrowing to int32
+	return _mm256_cvtpd_epi32(_mm256_sub_pd(whole, _mm256_mul_pd(n, _mm256_floor_pd(_mm256_mul_pd(whole, inv_n)))));
+}
+NVS_TARGET_AVX2 inline __m256 hermiteAVX2(__m256 const frac, __m256 const y0, __m256 const y1, __m256 const y2, __m256 const y3){
+	__m256 const half = _mm256_set1_ps(0.5f);
+	__m256 const c1 = _mm256_mul_ps(half, _mm256_sub_ps(y2, y0));
+	__m256 const c2 = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(y0, _mm256_mul_ps(_mm256_set1_ps(2.5f), y1)),
+												  _mm256_mul_ps(_mm256_set1_ps(2.f), y2)),
+									_mm256_mul_ps(half, y3));
+	__m256 const c3 = _mm256_add_ps(_mm256_mul_ps(half, _mm256_sub_ps(y3, y0)),
+									_mm256_mul_ps(_mm256_set1_ps(1.5f), _mm256_sub_ps(y1, y2)));
+	__m256 r = _mm256_add_ps(_mm256_mul_ps(c3, frac), c2);
+	r = _mm256_add_ps(_mm256_mul_ps(r, frac), c1);
+	return _mm256_add_ps(_mm256_mul_ps(r, frac), y1);
+}
+NVS_TARGET_AVX2 inline __m256 gatherHermiteAVX2(float const *const wave, __m256i const base, __m256 const frac){
+	// base in [0, n), so each tap is the same offsets from a shifted pointer, its neighbours in the guards at worst
+	__m256 const y0 = _mm256_i32gather_ps(wave - 1, base, 4);
+	__m256 const y1 = _mm256_i32gather_ps(wave, base, 4);
+	__m256 const y2 = _mm256_i32gather_ps(wave + 1, base, 4);
+	__m256 const y3 = _mm256_i32gather_ps(wave + 2, base, 4);
+	return hermiteAVX2(frac, y0, y1, y2, y3);
+}
+NVS_TARGET_AVX2 inline void gatherHermiteStereoAVX2(float const *const frames, __m256i const base, __m256 const frac,
+													 float *const outL, float *const outR){
+	__m256i const offset = _mm256_slli_epi32(base, 1);	// in floats, 2 per frame; each tap's right sample is the float after its left
+	_mm256_storeu_ps(outL, hermiteAVX2(frac, _mm256_i32gather_ps(frames - 2, offset, 4), _mm256_i32gather_ps(frames, offset, 4),
+									   _mm256_i32gather_ps(frames + 2, offset, 4), _mm256_i32gather_ps(frames + 4, offset, 4)));
+	_mm256_storeu_ps(outR, hermiteAVX2(frac, _mm256_i32gather_ps(frames - 1, offset, 4), _mm256_i32gather_ps(frames + 1, offset, 4),
+									   _mm256_i32gather_ps(frames + 3, offset, 4), _mm256_i32gather_ps(frames + 5, offset, 4)));
+}
+NVS_TARGET_AVX2 inline void splitIndicesAVX2(double const *const indices, __m256d const n_d, __m256d const inv_n_d, __m256i const n_i,
+											 __m256i &base, __m256 &frac){
+	__m256d const x_lo = _mm256_loadu_pd(indices);
+	__m256d const x_hi = _mm256_loadu_pd(indices + 4);
+	__m256d const whole_lo = _mm256_floor_pd(x_lo);
+	__m256d const whole_hi = _mm256_floor_pd(x_hi);
+	frac = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_sub_pd(x_hi, whole_hi)),
+						   _mm256_cvtpd_ps(_mm256_sub_pd(x_lo, whole_lo)));
+	base = _mm256_set_m128i(wrapWhole(whole_hi, n_d, inv_n_d), wrapWhole(whole_lo, n_d, inv_n_d));
+	base = wrapHigh(wrapLow(base, n_i), n_i);	// guards against the reciprocal landing one period off
+}
+NVS_TARGET_AVX2
+void hermiteGatherAVX2(float const *const wave, std::size_t const waveLength, double const *const indices, float *const out, std::size_t const count){
+	__m256d const n_d = _mm256_set1_pd(static_cast<double>(waveLength));
+	__m256d const inv_n_d = _mm256_set1_pd(1.0 / static_cast<double>(waveLength));
+	__m256i const n_i = _mm256_set1_epi32(static_cast<int>(waveLength));
+	
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i base;
+		__m256 frac;
+		splitIndicesAVX2(indices + i, n_d, inv_n_d, n_i, base, frac);
+		_mm256_storeu_ps(out + i, gatherHermiteAVX2(wave, base, frac));
+	}
+	if (i < count){
+		hermiteGatherPortable(wave, waveLength, indices + i, out + i, count - i);
+	}
+}
+NVS_TARGET_AVX2
+void hermiteGatherStereoAVX2(float const *const frames, std::size_t const numFrames, double const *const indices,
+							 float *const outL, float *const outR, std::size_t const count){
+	__m256d const n_d = _mm256_set1_pd(static_cast<double>(numFrames));
+	__m256d const inv_n_d = _mm256_set1_pd(1.0 / static_cast<double>(numFrames));
+	__m256i const n_i = _mm256_set1_epi32(static_cast<int>(numFrames));
+	
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i base;
+		__m256 frac;
+		splitIndicesAVX2(indices + i, n_d, inv_n_d, n_i, base, frac);
+		gatherHermiteStereoAVX2(frames, base, frac, outL + i, outR + i);
+	}
+	if (i < count){
+		hermiteGatherStereoPortable(frames, numFrames, indices + i, outL + i, outR + i, count - i);
+	}
+}
+NVS_TARGET_AVX2
+void hermiteGatherStereoSplitAVX2(float const *const frames, std::size_t const numFrames, std::int32_t const *const wholes, float const *const fracs,
+								  float *const outL, float *const outR, std::size_t const count){
+	__m256i const n_i = _mm256_set1_epi32(static_cast<int>(numFrames));
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i const base = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(wholes + i));
+		if (allWithin(base, n_i)){
+			gatherHermiteStereoAVX2(frames, base, _mm256_loadu_ps(fracs + i), outL + i, outR + i);
+		} else {	// the portable loop wraps them
+			hermiteGatherStereoPortable(frames, numFrames, wholes + i, fracs + i, outL + i, outR + i, 8);
+		}
+	}
+	if (i < count){
+		hermiteGatherStereoPortable(frames, numFrames, wholes + i, fracs + i, outL + i, outR + i, count - i);
+	}
+}
+NVS_TARGET_AVX2
+void hermiteGatherSplitAVX2(float const *const wave, std::size_t const waveLength, std::int32_t const *const wholes, float const *const fracs,
+							float *const out, std::size_t const count){
+	__m256i const n_i = _mm256_set1_epi32(static_cast<int>(waveLength));
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i const base = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(wholes + i));
+		if (allWithin(base, n_i)){
+			_mm256_storeu_ps(out + i, gatherHermiteAVX2(wave, base, _mm256_loadu_ps(fracs + i)));
+		} else {	// the portable loop wraps them
+			hermiteGatherPortable(wave, waveLength, wholes + i, fracs + i, out + i, 8);
+		}
+	}
+	if (i < count){
+		hermiteGatherPortable(wave, waveLength, wholes + i, fracs + i, out + i, count - i);
+	}
+}
+#endif
+
+using HermiteGatherFn = void (*)(float const *, std::size_t, double const *, float *, std::size_t);
+using HermiteGatherSplitFn = void (*)(float const *, std::size_t, std::int32_t const *, float const *, float *, std::size_t);
+HermiteGatherFn resolveHermiteGather(){
+#if NVS_INTERP_X86
+	if (juce::SystemStats::hasAVX2()){
+		return hermiteGatherAVX2;
+	}
+#endif
+	return hermiteGatherPortable;
+}
+HermiteGatherSplitFn resolveHermiteGatherSplit(){
+#if NVS_INTERP_X86
+	if (juce::SystemStats::hasAVX2()){
+		return hermiteGatherSplitAVX2;
+	}
+#endif
+	return hermiteGatherPortable;
+}
+HermiteGatherFn const dispatchedHermiteGather = resolveHermiteGather();
+HermiteGatherSplitFn const dispatchedHermiteGatherSplit = resolveHermiteGatherSplit();
+
+using HermiteGatherStereoFn = void (*)(float const *, std::size_t, double const *, float *, float *, std::size_t);
+using HermiteGatherStereoSplitFn = void (*)(float const *, std::size_t, std::int32_t const *, float const *, float *, float *, std::size_t);
+HermiteGatherStereoFn resolveHermiteGatherStereo(){
+#if NVS_INTERP_X86
+	if (juce::SystemStats::hasAVX2()){
+		return hermiteGatherStereoAVX2;
+	}
+#endif
+	return hermiteGatherStereoPortable;
+}
+HermiteGatherStereoSplitFn resolveHermiteGatherStereoSplit(){
+#if NVS_INTERP_X86
+	if (juce::SystemStats::hasAVX2()){
+		return hermiteGatherStereoSplitAVX2;
+	}
+#endif
+	return hermiteGatherStereoPortable;
+}
+HermiteGatherStereoFn const dispatchedHermiteGatherStereo = resolveHermiteGatherStereo();
+HermiteGatherStereoSplitFn const dispatchedHermiteGatherStereoSplit = resolveHermiteGatherStereoSplit();
+
+bool fitsStereoKernel(std::size_t const numFrames){	// 32-bit gather offsets of 2 floats per frame
+	return numFrames <= static_cast<std::size_t>(std::numeric_limits<int>::max() / 2);
+}
+}	// end anonymous namespace
+
+void hermiteGatherPortable(float const *const wave, std::size_t const waveLength, double const *const indices, float *const out, std::size_t const count){
+	auto const n = static_cast<long long>(waveLength);
+	for (std::size_t i = 0; i < count; ++i){
+		double const whole = std::floor(indices[i]);
+		float const frac = static_cast<float>(indices[i] - whole);
+		float const *const y = wave + wrapRead(static_cast<long long>(whole), n);
+		out[i] = hermite(frac, y[-1], y[0], y[1], y[2]);
+	}
+}
+void hermiteGather(float const *const wave, std::size_t const waveLength, double const *const indices, float *const out, std::size_t const count){
+	assert (waveLength > 0);
+	if (waveLength > static_cast<std::size_t>(std::numeric_limits<int>::max())){
+		// the vector kernel needs 32-bit gather offsets
+		hermiteGatherPortable(wave, waveLength, indices, out, count);
+		return;
+	}
+	dispatchedHermiteGather(wave, waveLength, indices, out, count);
+}
+void hermiteGatherPortable(float const *const wave, std::size_t const waveLength, std::int32_t const *const wholes, float const *const fracs,
+						   float *const out, std::size_t const count){
+	auto const n = static_cast<long long>(waveLength);
+	for (std::size_t i = 0; i < count; ++i){
+		float const *const y = wave + wrapRead(wholes[i], n);
+		out[i] = hermite(fracs[i], y[-1], y[0], y[1], y[2]);
+	}
+}
+void hermiteGather(float const *const wave, std::size_t const waveLength, std::int32_t const *const wholes, float const *const fracs,
+				   float *const out, std::size_t const count){
+	assert (waveLength > 0);
+	if (waveLength > static_cast<std::size_t>(std::numeric_limits<int>::max())){
+		hermiteGatherPortable(wave, waveLength, wholes, fracs, out, count);
+		return;
+	}
+	dispatchedHermiteGatherSplit(wave, waveLength, wholes, fracs, out, count);
+}
+SincTable::SincTable(){
+	constexpr int half {taps / 2};
+	for (int p = 0; p <= numPhases; ++p){
+		double const frac = static_cast<double>(p) / numPhases;
+		std::array<double, taps> h;
+		double sum {0.0};
+		for (int k = 0; k < taps; ++k){
+			double const x = static_cast<double>(k - (half - 1)) - frac;	// tap's distance from the read position
+			double const arg = 2.0 * cutoff * x;
+			double const sinc = (std::abs(arg) < 1e-12) ? 1.0 : std::sin(std::numbers::pi * arg) / (std::numbers::pi * arg);
+			h[static_cast<std::size_t>(k)] = sinc * kaiserWindow(x / half, kaiserBeta);
+			sum += h[static_cast<std::size_t>(k)];
+		}
+		for (int k = 0; k < taps; ++k){
+			coefficients[static_cast<std::size_t>(p * taps + k)] = static_cast<float>(h[static_cast<std::size_t>(k)] / sum);
+		}
+	}
+}
+double kaiserWindow(double const r, double const beta){
+	return (std::abs(r) < 1.0) ? besselI0(beta * std::sqrt(1.0 - r * r)) / besselI0(beta) : 0.0;
+}
+SincTable const &sincTable(){
+	return sincTableInstance;
+}
+float linearRead(float const *const wave, std::size_t const waveLength, double const index){
+	double const whole = std::floor(index);
+	float const *const y = wave + wrapRead(static_cast<long long>(whole), static_cast<long long>(waveLength));
+	return linear(static_cast<float>(index - whole), y[0], y[1]);
+}
+float hermiteRead(float const *const wave, std::size_t const waveLength, double const index){
+	double const whole = std::floor(index);
+	float const *const y = wave + wrapRead(static_cast<long long>(whole), static_cast<long long>(waveLength));
+	return hermite(static_cast<float>(index - whole), y[-1], y[0], y[1], y[2]);
+}
+float sincRead(float const *const wave, std::size_t const waveLength, double const index){
+	double const whole = std::floor(index);
+	auto const n = static_cast<long long>(waveLength);
+	return sincAt(sincTableInstance, wave, n, wrapRead(static_cast<long long>(whole), n), static_cast<float>(index - whole));
+}
+
+template <>
+void gather<Quality::linear>(float const *const wave, std::size_t const waveLength, double const *const indices, float *const out, std::size_t const count){
+	auto const n = static_cast<long long>(waveLength);
+	for (std::size_t i = 0; i < count; ++i){
+		double const whole = std::floor(indices[i]);
+		float const *const y = wave + wrapRead(static_cast<long long>(whole), n);
+		out[i] = linear(static_cast<float>(indices[i] - whole), y[0], y[1]);
+	}
+}
+template <>
+void gather<Quality::hermite>(float const *const wave, std::size_t const waveLength, double const *const indices, float *const out, std::size_t const count){
+	hermiteGather(wave, waveLength, indices, out, count);
+}
+template <>
+void gather<Quality::sinc>(float const *const wave, std::size_t const waveLength, double const *const indices, float *const out, std::size_t const count){
+	for (std::size_t i = 0; i < count; ++i){
+		out[i] = sincRead(wave, waveLength, indices[i]);
+	}
+}
+template <>
+void gather<Quality::linear>(float const *const wave, std::size_t const waveLength, std::int32_t const *const wholes, float const *const fracs,
+							 float *const out, std::size_t const count){
+	auto const n = static_cast<long long>(waveLength);
+	for (std::size_t i = 0; i < count; ++i){
+		float const *const y = wave + wrapRead(wholes[i], n);
+		out[i] = linear(fracs[i], y[0], y[1]);
+	}
+}
+template <>
+void gather<Quality::hermite>(float const *const wave, std::size_t const waveLength, std::int32_t const *const wholes, float const *const fracs,
+							  float *const out, std::size_t const count){
+	hermiteGather(wave, waveLength, wholes, fracs, out, count);
+}
+template <>
+void gather<Quality::sinc>(float const *const wave, std::size_t const waveLength, std::int32_t const *const wholes, float const *const fracs,
+						   float *const out, std::size_t const count){
+	auto const n = static_cast<long long>(waveLength);
+	for (std::size_t i = 0; i < count; ++i){
+		out[i] = sincAt(sincTableInstance, wave, n, wrapRead(wholes[i], n), fracs[i]);
+	}
+}
+template <>
+void gatherStereo<Quality::linear>(float const *const frames, std::size_t const numFrames, double const *const indices,
+								   float *const outL, float *const outR, std::size_t const count){
+	auto const n = static_cast<long long>(numFrames);
+	for (std::size_t i = 0; i < count; ++i){
+		double const whole = std::floor(indices[i]);
+		float const frac = static_cast<float>(indices[i] - whole);
+		float const *const y = frames + 2 * wrapRead(static_cast<long long>(whole), n);
+		outL[i] = linear(frac, y[0], y[2]);
+		outR[i] = linear(frac, y[1], y[3]);
+	}
+}
+template <>
+void gatherStereo<Quality::hermite>(float const *const frames, std::size_t const numFrames, double const *const indices,
+									float *const outL, float *const outR, std::size_t const count){
+	assert (numFrames > 0);
+	if (!fitsStereoKernel(numFrames)){
+		hermiteGatherStereoPortable(frames, numFrames, indices, outL, outR, count);
+		return;
+	}
+	dispatchedHermiteGatherStereo(frames, numFrames, indices, outL, outR, count);
+}
+template <>
+void gatherStereo<Quality::sinc>(float const *const frames, std::size_t const numFrames, double const *const indices,
+								 float *const outL, float *const outR, std::size_t const count){
+	auto const n = static_cast<long long>(numFrames);
+	for (std::size_t i = 0; i < count; ++i){
+		double const whole = std::floor(indices[i]);
+		sincStereoAt(sincTableInstance, frames, n, wrapRead(static_cast<long long>(whole), n),
+					 static_cast<float>(indices[i] - whole), outL[i], outR[i]);
+	}
+}
+template <>
+void gatherStereo<Quality::linear>(float const *const frames, std::size_t const numFrames, std::int32_t const *const wholes, float const *const fracs,
+								   float *const outL, float *const outR, std::size_t const count){
+	auto const n = static_cast<long long>(numFrames);
+	for (std::size_t i = 0; i < count; ++i){
+		float const *const y = frames + 2 * wrapRead(wholes[i], n);
+		outL[i] = linear(fracs[i], y[0], y[2]);
+		outR[i] = linear(fracs[i], y[1], y[3]);
+	}
+}
+template <>
+void gatherStereo<Quality::hermite>(float const *const frames, std::size_t const numFrames, std::int32_t const *const wholes, float const *const fracs,
+									float *const outL, float *const outR, std::size_t const count){
+	assert (numFrames > 0);
+	if (!fitsStereoKernel(numFrames)){
+		hermiteGatherStereoPortable(frames, numFrames, wholes, fracs, outL, outR, count);
+		return;
+	}
+	dispatchedHermiteGatherStereoSplit(frames, numFrames, wholes, fracs, outL, outR, count);
+}
+template <>
+void gatherStereo<Quality::sinc>(float const *const frames, std::size_t const numFrames, std::int32_t const *const wholes, float const *const fracs,
+								 float *const outL, float *const outR, std::size_t const count){
+	auto const n = static_cast<long long>(numFrames);
+	for (std::size_t i = 0; i < count; ++i){
+		sincStereoAt(sincTableInstance, frames, n, wrapRead(wholes[i], n), fracs[i], outL[i], outR[i]);
+	}
+}
+bool usesAVX2(){
+	return dispatchedHermiteGather != static_cast<HermiteGatherFn>(hermiteGatherPortable);
+}
+}	// namespace nvs::gran::interp
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    Interpolation.h
+    Created: 16 Oct 2026 1:05:52pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace nvs::gran::interp {
+enum class Quality {
+	linear,		// 2 taps: the cheapest, for dense live clouds; dulls the top octave
+	hermite,	// 4 taps: the default
+	sinc		// SincTable::taps taps of a windowed sinc: for offline renders
+};
+/**
+ Every read below is of a source padded with guardFrames frames on either side, copies of the frames at the other end
+ (see SourceBuffer). A read position in [0, waveLength) then reads all of its taps without wrapping any of them; only a
+ position outside that, as of a grain running past the end of its read bounds, is wrapped into it first, once. That holds
+ for the split forms' wholes too, so no position, in any build, reads past the guards.
+ */
+inline constexpr std::size_t guardFrames {16};	// at least the widest kernel's reach, SincTable::taps / 2; and 64 bytes of mono floats
+
+/**
+ Batched 4-point, 3rd-order Hermite reads with wrapped bounds: the same interpolation as
+ gen::peek<float, interpolationModes_e::hermite, boundsModes_e::wrap>, but for many fractional indices at once.
+ out[i] = wave(indices[i]) for i in [0, count).
+ 
+ The implementation is chosen once at runtime: an AVX2 gather kernel where the CPU supports it, otherwise a portable loop.
+ Both paths use the identical formula.
+ */
+void hermiteGather(float const *wave, std::size_t waveLength, double const *indices, float *out, std::size_t count);
+
+// always available; useful to compare against the dispatched kernel
+void hermiteGatherPortable(float const *wave, std::size_t waveLength, double const *indices, float *out, std::size_t count);
+
+/**
+ The same read with each index already split into a whole sample in [0, waveLength) and a fraction in [0, 1]
+ (see FixedPointPhase), so the AVX2 kernel works on 8 lanes without any double arithmetic. A whole outside [0, waveLength)
+ is wrapped, as above; the AVX2 kernel hands any 8 lanes holding one to the portable loop.
+ */
+void hermiteGather(float const *wave, std::size_t waveLength, std::int32_t const *wholes, float const *fracs, float *out, std::size_t count);
+void hermiteGatherPortable(float const *wave, std::size_t waveLength, std::int32_t const *wholes, float const *fracs, float *out, std::size_t count);
+
+bool usesAVX2();
+
+/**
+ Polyphase windowed-sinc coefficients: numPhases + 1 fractional offsets in [0, 1] (the extra one so that neighbouring phases
+ can be interpolated) of a Kaiser-windowed sinc, taps long, cut off a little under Nyquist and normalised to unity gain.
+ Tap k of a read at whole + frac weights sample whole + k - (taps / 2 - 1).
+ */
+struct SincTable {
+	static constexpr int taps {16};
+	static constexpr int numPhases {256};
+	static constexpr double cutoff {0.45};	// cycles per sample
+	static constexpr double kaiserBeta {8.0};
+	
+	static_assert(taps / 2 <= static_cast<int>(guardFrames));
+	
+	SincTable();
+	float const *phase(int p) const { return &coefficients[static_cast<std::size_t>(p * taps)]; }
+	
+	alignas(64) std::array<float, (numPhases + 1) * taps> coefficients;
+};
+SincTable const &sincTable();	// built during static initialisation, never on the audio thread
+
+double kaiserWindow(double r, double beta);	// r in [-1, 1], from one edge of the window to the other; 0 outside
+
+/**
+ The gathers above, for a Quality chosen at compile time, so that a renderer templated on it never branches on it per read.
+ hermite is the dispatched kernel; linear and sinc are portable loops.
+ */
+template <Quality Q>
+void gather(float const *wave, std::size_t waveLength, double const *indices, float *out, std::size_t count);
+template <Quality Q>
+void gather(float const *wave, std::size_t waveLength, std::int32_t const *wholes, float const *fracs, float *out, std::size_t count);
+
+template <> void gather<Quality::linear>(float const *, std::size_t, double const *, float *, std::size_t);
+template <> void gather<Quality::hermite>(float const *, std::size_t, double const *, float *, std::size_t);
+template <> void gather<Quality::sinc>(float const *, std::size_t, double const *, float *, std::size_t);
+template <> void gather<Quality::linear>(float const *, std::size_t, std::int32_t const *, float const *, float *, std::size_t);
+template <> void gather<Quality::hermite>(float const *, std::size_t, std::int32_t const *, float const *, float *, std::size_t);
+template <> void gather<Quality::sinc>(float const *, std::size_t, std::int32_t const *, float const *, float *, std::size_t);
+
+// single wrapped reads, for the scalar renderer
+float linearRead(float const *wave, std::size_t waveLength, double index);
+float hermiteRead(float const *wave, std::size_t waveLength, double index);
+float sincRead(float const *wave, std::size_t waveLength, double index);
+
+/**
+ The gathers above, over interleaved stereo frames (see SourceBuffer): one neighbourhood of numFrames-wrapped frames per
+ index, whose left and right samples share cache lines, interpolated into outL[i] and outR[i] with the same weights.
+ hermite is an AVX2 kernel where the CPU supports it, like hermiteGather.
+ */
+template <Quality Q>
+void gatherStereo(float const *frames, std::size_t numFrames, double const *indices, float *outL, float *outR, std::size_t count);
+template <Quality Q>
+void gatherStereo(float const *frames, std::size_t numFrames, std::int32_t const *wholes, float const *fracs,
+				  float *outL, float *outR, std::size_t count);
+
+template <> void gatherStereo<Quality::linear>(float const *, std::size_t, double const *, float *, float *, std::size_t);
+template <> void gatherStereo<Quality::hermite>(float const *, std::size_t, double const *, float *, float *, std::size_t);
+template <> void gatherStereo<Quality::sinc>(float const *, std::size_t, double const *, float *, float *, std::size_t);
+template <> void gatherStereo<Quality::linear>(float const *, std::size_t, std::int32_t const *, float const *, float *, float *, std::size_t);
+template <> void gatherStereo<Quality::hermite>(float const *, std::size_t, std::int32_t const *, float const *, float *, float *, std::size_t);
+template <> void gatherStereo<Quality::sinc>(float const *, std::size_t, std::int32_t const *, float const *, float *, float *, std::size_t);
+}	// namespace nvs::gran::interp
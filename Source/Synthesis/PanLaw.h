@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    PanLaw.h
+    Created: 16 Oct 2026 9:37:02pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <algorithm>
+#include <numbers>
+
+namespace nvs::gran {
+
+enum class PanLaw {
+	equalPower,	// cos / sin: -3 dB at the centre
+	linear,		// 1 - p / p: -6 dB at the centre
+	minus4_5dB	// geometric mean of the two
+};
+
+struct PanGains {
+	float L {1.f};
+	float R {0.f};
+};
+
+namespace pan_detail {
+constexpr double sine(double const x){	// Taylor series; accurate to double precision over [0, pi/2]
+	double term = x;
+	double sum = x;
+	for (int n = 1; n < 12; ++n){
+		term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+constexpr double squareRoot(double const x){
+	if (x <= 0.0){
+		return 0.0;
+	}
+	double r = x < 1.0 ? 1.0 : x;
+	for (int i = 0; i < 64; ++i){
+		r = 0.5 * (r + x / r);
+	}
+	return r;
+}
+constexpr PanGains gainsFor(PanLaw const law, double const p){	// p: 0 (left) to 1 (right)
+	double const halfPi = 0.5 * std::numbers::pi;
+	double const cosL = sine(halfPi * (1.0 - p));
+	double const sinR = sine(halfPi * p);
+	switch (law){
+		case PanLaw::equalPower:
+			return {static_cast<float>(cosL), static_cast<float>(sinR)};
+		case PanLaw::linear:
+			return {static_cast<float>(1.0 - p), static_cast<float>(p)};
+		case PanLaw::minus4_5dB:
+			return {static_cast<float>(squareRoot((1.0 - p) * cosL)), static_cast<float>(squareRoot(p * sinR))};
+	}
+	return {};
+}
+
+inline constexpr std::size_t numSegments {256};
+inline constexpr std::size_t numLaws {3};
+using Table = std::array<std::array<PanGains, numSegments + 1>, numLaws>;
+
+constexpr Table makeTable(){
+	Table table {};
+	for (std::size_t law = 0; law < numLaws; ++law){
+		for (std::size_t i = 0; i <= numSegments; ++i){
+			table[law][i] = gainsFor(static_cast<PanLaw>(law), static_cast<double>(i) / static_cast<double>(numSegments));
+		}
+	}
+	return table;
+}
+inline constexpr Table table = makeTable();
+}	// namespace pan_detail
+
+/**
+ L/R gains for a pan in radians, 0 (left) to pi/2 (right), read from a table built at compile time.
+ Grains resolve their gains once, at spawn, so panning costs two multiplies per sample.
+ */
+inline PanGains panGains(PanLaw const law, float const pan){
+	float const x = std::clamp(pan * static_cast<float>(2.0 / std::numbers::pi), 0.f, 1.f) * static_cast<float>(pan_detail::numSegments);
+	std::size_t const i = std::min(static_cast<std::size_t>(x), pan_detail::numSegments - 1);
+	float const frac = x - static_cast<float>(i);
+	auto const &row = pan_detail::table[static_cast<std::size_t>(law)];
+	return {
+		row[i].L + frac * (row[i + 1].L - row[i].L),
+		row[i].R + frac * (row[i + 1].R - row[i].R)
+	};
+}
+}	// namespace nvs::gran
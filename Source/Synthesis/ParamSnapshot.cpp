@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    ParamSnapshot.cpp
+    Created: 16 Oct 2026 11:52:08pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "ParamSnapshot.h"
+#include "../Params/params.h"
+#include <array>
+#include <utility>
+
+namespace nvs::gran {
+
+namespace {
+using Field = float ParamSnapshot::*;
+using RampField = ParamRamp ParamSnapshot::*;
+constexpr std::array<std::pair<char const *, Field>, 18> fieldsByID {{
+	{"transpose",		&ParamSnapshot::transpose},
+	{"speed",			&ParamSnapshot::speed},
+	{"duration",		&ParamSnapshot::duration},
+	{"skew",			&ParamSnapshot::skew},
+	{"plateau",			&ParamSnapshot::plateau},
+	{"pan",				&ParamSnapshot::pan},
+	{"transpose_rand",	&ParamSnapshot::transpose_rand},
+	{"position_rand",	&ParamSnapshot::position_rand},
+	{"speed_rand",		&ParamSnapshot::speed_rand},
+	{"duration_rand",	&ParamSnapshot::duration_rand},
+	{"skew_rand",		&ParamSnapshot::skew_rand},
+	{"plateau_rand",	&ParamSnapshot::plateau_rand},
+	{"pan_rand",		&ParamSnapshot::pan_rand},
+	{"amp_env_attack",	&ParamSnapshot::amp_env_attack},
+	{"amp_env_decay",	&ParamSnapshot::amp_env_decay},
+	{"amp_env_sustain",	&ParamSnapshot::amp_env_sustain},
+	{"amp_env_release",	&ParamSnapshot::amp_env_release},
+	{"scanner_rate",	&ParamSnapshot::scanner_rate}
+}};
+constexpr std::array<std::pair<char const *, RampField>, 4> rampFieldsByID {{
+	{"position",		&ParamSnapshot::position},
+	{"scanner_amount",	&ParamSnapshot::scanner_amount},
+	{"fx_grain_drive",	&ParamSnapshot::fx_grain_drive},
+	{"fx_makeup_gain",	&ParamSnapshot::fx_makeup_gain}
+}};
+
+template <typename FieldsByID, typename Bindings>
+void bind(juce::AudioProcessorValueTreeState &apvts, nvs::param::ParameterDef const &pd, FieldsByID const &fieldsByID, Bindings &bindings){
+	for (auto const &[id, field] : fieldsByID){
+		if (pd.ID == id){
+			auto const *source = apvts.getRawParameterValue(pd.ID);
+			jassert (source != nullptr);
+			if (source){
+				bindings.push_back({source, field});
+			}
+			return;
+		}
+	}
+}
+}	// end anonymous namespace
+
+ParamSnapshotReader::ParamSnapshotReader(juce::AudioProcessorValueTreeState &apvts){
+	_bindings.reserve(fieldsByID.size());
+	_ramp_bindings.reserve(rampFieldsByID.size());
+	for (auto const &pd : nvs::param::ALL_PARAMETERS){
+		bind(apvts, pd, fieldsByID, _bindings);
+		bind(apvts, pd, rampFieldsByID, _ramp_bindings);
+	}
+	// every snapshot field should have a parameter
+	jassert (_bindings.size() == fieldsByID.size());
+	jassert (_ramp_bindings.size() == rampFieldsByID.size());
+}
+void ParamSnapshotReader::read(ParamSnapshot &snapshot, int const blockSize){
+	snapshot.block_size = blockSize;
+	for (auto const &b : _bindings){
+		snapshot.*(b.field) = b.source->load(std::memory_order_relaxed);
+	}
+	for (auto const &b : _ramp_bindings){
+		auto &ramp = snapshot.*(b.field);
+		float const previous = ramp.end;
+		ramp.end = b.source->load(std::memory_order_relaxed);
+		ramp.start = _primed ? previous : ramp.end;
+	}
+	_primed = true;
+}
+}	// namespace nvs::gran
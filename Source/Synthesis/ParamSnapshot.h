@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    ParamSnapshot.h
+    Created: 16 Oct 2026 11:52:08pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+namespace nvs::gran {
+
+/**
+ A continuous parameter across one block: from the value it had at the end of the last block to its value now.
+ Consumers evaluate it where they use it (e.g. at a grain's onset), so automation glides rather than steps at block boundaries.
+ */
+struct ParamRamp {
+	float start {0.f};
+	float end {0.f};
+	float at(float const phase) const {	// phase: 0 at the block's first sample, 1 at its end
+		return start + phase * (end - start);
+	}
+};
+
+/**
+ The synth's parameter values for one block, as plain floats.
+ Read once per block by the synth and shared by every voice and grain, so setParams is a handful of member reads rather than
+ a hashed string lookup per parameter, per grain.
+ */
+struct ParamSnapshot {
+	int block_size {0};	// the samples the ramps span
+	float rampPhase(int const sampleInBlock) const {
+		return (block_size > 0) ? std::clamp(static_cast<float>(sampleInBlock) / static_cast<float>(block_size), 0.f, 1.f) : 1.f;
+	}
+	
+	float transpose {0.f};
+	ParamRamp position {0.f, 0.f};
+	float speed {50.f};
+	float duration {0.1f};
+	float skew {0.5f};
+	float plateau {1.f};
+	float pan {0.5f};
+
+	float transpose_rand {0.f};
+	float position_rand {0.f};
+	float speed_rand {0.f};
+	float duration_rand {0.f};
+	float skew_rand {0.f};
+	float plateau_rand {0.f};
+	float pan_rand {0.5f};
+
+	float amp_env_attack {0.05f};
+	float amp_env_decay {1.f};
+	float amp_env_sustain {0.85f};
+	float amp_env_release {1.f};
+
+	float scanner_rate {0.f};
+	ParamRamp scanner_amount {0.f, 0.f};
+
+	ParamRamp fx_grain_drive {1.f, 1.f};
+	ParamRamp fx_makeup_gain {1.f, 1.f};
+};
+
+/**
+ Binds each ParamSnapshot field to its APVTS value once, walking nvs::param::ALL_PARAMETERS, so that read() is a straight copy
+ of atomics. Parameters without a snapshot field (e.g. the TSN ones) are skipped.
+ A ramp's new start is its previous end; the first read starts every ramp at its end.
+ */
+class ParamSnapshotReader {
+public:
+	explicit ParamSnapshotReader(juce::AudioProcessorValueTreeState &apvts);
+	void read(ParamSnapshot &snapshot, int blockSize);
+private:
+	template <typename Field>
+	struct Binding {
+		std::atomic<float> const *source;
+		Field ParamSnapshot::*field;
+	};
+	std::vector<Binding<float>> _bindings;
+	std::vector<Binding<ParamRamp>> _ramp_bindings;
+	bool _primed {false};
+};
+}	// namespace nvs::gran
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    RenderWorkers.cpp
+    Created: 16 Oct 2026 2:41:17am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "RenderWorkers.h"
+#include <algorithm>
+#include <cassert>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace nvs::gran {
+
+namespace {
+// a block is a few ms, so a worker spins for a short while before sleeping on the atomic, and usually catches the next block awake
+constexpr int spinIterations = 4096;
+
+constexpr std::uint64_t packRange(std::uint32_t const front, std::uint32_t const back){
+	return (static_cast<std::uint64_t>(front) << 32) | back;
+}
+constexpr std::uint32_t rangeFront(std::uint64_t const range){
+	return static_cast<std::uint32_t>(range >> 32);
+}
+constexpr std::uint32_t rangeBack(std::uint64_t const range){
+	return static_cast<std::uint32_t>(range);
+}
+
+inline void spinPause(){
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	_mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+	__asm__ __volatile__ ("yield");
+#endif
+}
+}	// end anonymous namespace
+
+class RenderWorkerPool::Worker	:	public juce::Thread
+{
+public:
+	Worker(RenderWorkerPool &pool, int const thread)
+	:	juce::Thread("grain render " + juce::String(thread))
+	,	_pool(pool)
+	,	_thread(thread)
+	,	_seen(pool._generation.load(std::memory_order_relaxed))	// before the thread starts, so it cannot miss the first run()
+	{}
+	void run() override {
+		while (true){
+			_seen = _pool.awaitGeneration(_seen);
+			if (threadShouldExit()){
+				return;
+			}
+			_pool._invoke(_pool._context, _thread);
+			_pool.finishedOne();
+		}
+	}
+private:
+	RenderWorkerPool &_pool;
+	int const _thread;
+	std::uint32_t _seen;
+};
+
+RenderWorkerPool::RenderWorkerPool() = default;
+RenderWorkerPool::~RenderWorkerPool(){
+	stop();
+}
+void RenderWorkerPool::start(int const numWorkers){
+	stop();
+	_workers.reserve(static_cast<std::size_t>(std::max(numWorkers, 0)));
+	for (int i = 0; i < numWorkers; ++i){
+		auto &worker = _workers.emplace_back(std::make_unique<Worker>(*this, i + 1));
+		if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(10))){
+			worker->startThread(juce::Thread::Priority::highest);
+		}
+	}
+}
+void RenderWorkerPool::stop(){
+	if (_workers.empty()){
+		return;
+	}
+	for (auto &worker : _workers){
+		worker->signalThreadShouldExit();
+	}
+	_generation.fetch_add(1, std::memory_order_release);	// wake them to see the exit flag
+	_generation.notify_all();
+	for (auto &worker : _workers){
+		worker->stopThread(1000);
+	}
+	_workers.clear();
+}
+void RenderWorkerPool::dispatch(){
+	_pending.store(static_cast<int>(_workers.size()), std::memory_order_relaxed);
+	_generation.fetch_add(1, std::memory_order_release);
+	_generation.notify_all();
+	_invoke(_context, 0);
+	awaitWorkers();
+}
+std::uint32_t RenderWorkerPool::awaitGeneration(std::uint32_t const seen) const {
+	for (int i = 0; i < spinIterations; ++i){
+		if (auto const g = _generation.load(std::memory_order_acquire); g != seen){
+			return g;
+		}
+		spinPause();
+	}
+	_generation.wait(seen, std::memory_order_acquire);
+	return _generation.load(std::memory_order_acquire);
+}
+void RenderWorkerPool::finishedOne(){
+	if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1){
+		_pending.notify_one();
+	}
+}
+void RenderWorkerPool::awaitWorkers(){
+	for (int i = 0; i < spinIterations; ++i){
+		if (_pending.load(std::memory_order_acquire) == 0){
+			return;
+		}
+		spinPause();
+	}
+	for (int p = _pending.load(std::memory_order_acquire); p != 0; p = _pending.load(std::memory_order_acquire)){
+		_pending.wait(p, std::memory_order_acquire);
+	}
+}
+
+void WorkStealingChunks::setNumThreads(int const numThreads){
+	_num_threads = std::max(numThreads, 1);
+	_runs = std::make_unique<Run[]>(static_cast<std::size_t>(_num_threads));
+}
+void WorkStealingChunks::deal(int const numChunks){
+	assert (_runs != nullptr);
+	auto const total = static_cast<std::uint32_t>(std::max(numChunks, 0));
+	auto const threads = static_cast<std::uint32_t>(_num_threads);
+	for (std::uint32_t t = 0; t < threads; ++t){
+		_runs[t].range.store(packRange(total * t / threads, total * (t + 1) / threads), std::memory_order_relaxed);
+	}
+}
+std::optional<int> WorkStealingChunks::next(int const thread){
+	if (auto const own = takeFront(_runs[static_cast<std::size_t>(thread)])){
+		return own;
+	}
+	for (int k = 1; k < _num_threads; ++k){
+		if (auto const stolen = takeBack(_runs[static_cast<std::size_t>((thread + k) % _num_threads)])){
+			return stolen;
+		}
+	}
+	return std::nullopt;
+}
+std::optional<int> WorkStealingChunks::takeFront(Run &run){
+	auto range = run.range.load(std::memory_order_relaxed);
+	while (rangeFront(range) < rangeBack(range)){
+		if (run.range.compare_exchange_weak(range, packRange(rangeFront(range) + 1, rangeBack(range)), std::memory_order_relaxed)){
+			return static_cast<int>(rangeFront(range));
+		}
+	}
+	return std::nullopt;
+}
+std::optional<int> WorkStealingChunks::takeBack(Run &run){
+	auto range = run.range.load(std::memory_order_relaxed);
+	while (rangeFront(range) < rangeBack(range)){
+		if (run.range.compare_exchange_weak(range, packRange(rangeFront(range), rangeBack(range) - 1), std::memory_order_relaxed)){
+			return static_cast<int>(rangeBack(range) - 1);
+		}
+	}
+	return std::nullopt;
+}
+}	// namespace nvs::gran
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    RenderWorkers.h
+    Created: 16 Oct 2026 2:41:17am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace nvs::gran {
+
+/**
+ A fixed set of real-time worker threads that run one job per audio block alongside the calling (audio) thread.
+ Hand-off and completion are atomics that are spun on briefly and then waited on, so once started, run() neither locks
+ nor allocates. start() and stop() do both, so call them from prepareToPlay / the destructor, never while rendering.
+ */
+class RenderWorkerPool {
+public:
+	RenderWorkerPool();
+	~RenderWorkerPool();
+
+	void start(int numWorkers);	// threads besides the caller; restarts the pool if it is already running
+	void stop();
+	int getNumThreads() const {	// including the caller
+		return static_cast<int>(_workers.size()) + 1;
+	}
+	/**
+	 Calls job(thread) once for every thread in [0, getNumThreads()): the caller runs job(0) and the workers the rest.
+	 Returns when all of them have returned. job must outlive the call, and must not itself call run().
+	 */
+	template <typename Job>
+	void run(Job &job){
+		_context = &job;
+		_invoke = [](void *context, int const thread){
+			(*static_cast<Job *>(context))(thread);
+		};
+		dispatch();
+	}
+private:
+	class Worker;
+	std::vector<std::unique_ptr<Worker>> _workers;
+
+	std::atomic<std::uint32_t> _generation {0};	// bumped once per run(); workers wake on the change
+	std::atomic<int> _pending {0};				// workers yet to finish the current run()
+	void *_context {nullptr};
+	void (*_invoke)(void *, int) {nullptr};
+
+	void dispatch();
+	std::uint32_t awaitGeneration(std::uint32_t seen) const;
+	void finishedOne();
+	void awaitWorkers();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderWorkerPool)
+};
+
+/**
+ Work stealing over the chunk indices [0, numChunks) of one parallel job.
+ deal() gives each thread a contiguous run of chunks. A thread takes from the front of its own run and, once that is empty,
+ steals from the back of the others', so a thread that drew the expensive chunks is helped rather than waited on.
+ A run is a single 64-bit atomic (front, back): taking and stealing are one compare-exchange each, and never block.
+ */
+class WorkStealingChunks {
+public:
+	void setNumThreads(int numThreads);	// allocates
+	void deal(int numChunks);	// before the job is dispatched
+	std::optional<int> next(int thread);	// nullopt once every chunk has been taken
+private:
+	struct alignas(64) Run {
+		std::atomic<std::uint64_t> range {0};
+	};
+	std::unique_ptr<Run[]> _runs;
+	int _num_threads {0};
+	
+	static std::optional<int> takeFront(Run &run);
+	static std::optional<int> takeBack(Run &run);
+};
+}	// namespace nvs::gran
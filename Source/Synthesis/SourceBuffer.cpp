@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    SourceBuffer.cpp
+    Created: 17 Oct 2026 3:12:40pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "SourceBuffer.h"
+#include <algorithm>
+#include <cassert>
+
+namespace nvs::gran {
+
+SourceBuffer::SourceBuffer(int const numChannels, std::size_t const length)
+:	_storage(static_cast<std::size_t>(numChannels) * (length + 2 * interp::guardFrames))
+,	_length(length)
+,	_num_channels(numChannels)
+{
+	assert ((numChannels > 0) && (numChannels <= maxChannels));
+}
+SourceBuffer::SourceBuffer(juce::AudioBuffer<float> const &planar)
+:	SourceBuffer(std::clamp(planar.getNumChannels(), 1, maxChannels), static_cast<std::size_t>(planar.getNumSamples()))
+{
+	if (planar.getNumChannels() == 0){
+		return;	// silent
+	}
+	auto const stride = static_cast<std::size_t>(_num_channels);
+	float *const frames = getFrames();
+	for (int c = 0; c < _num_channels; ++c){
+		// how many of the planar channels fold into this one
+		int const folded = (planar.getNumChannels() - c + _num_channels - 1) / _num_channels;
+		float const gain = 1.f / static_cast<float>(folded);
+		for (int p = c; p < planar.getNumChannels(); p += _num_channels){
+			float const *const in = planar.getReadPointer(p);
+			float *const out = frames + c;
+			for (std::size_t i = 0; i < _length; ++i){
+				out[i * stride] += gain * in[i];
+			}
+		}
+	}
+	fillGuards();
+}
+SourceBuffer::SourceBuffer(SourceView const &source)
+:	SourceBuffer(source.numChannels, source.length)
+{
+	auto const guarded = static_cast<std::size_t>(_num_channels) * (_length + 2 * interp::guardFrames);
+	std::copy_n(source.frames - guardSamples(), guarded, _storage.data());	// its guards too
+}
+void SourceBuffer::fillGuards(){
+	if (_length == 0){
+		return;
+	}
+	auto const stride = static_cast<std::size_t>(_num_channels);
+	auto const guard = static_cast<long long>(interp::guardFrames);
+	auto const n = static_cast<long long>(_length);
+	float *const frames = getFrames();
+	auto const copyFrame = [&](long long const to){	// from where a wrapped read would find it
+		long long const from = ((to % n) + n) % n;
+		std::copy_n(frames + from * static_cast<long long>(stride), stride, frames + to * static_cast<long long>(stride));
+	};
+	for (long long i = 1; i <= guard; ++i){
+		copyFrame(-i);
+		copyFrame(n - 1 + i);
+	}
+}
+}	// namespace nvs::gran
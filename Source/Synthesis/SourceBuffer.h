@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    SourceBuffer.h
+    Created: 17 Oct 2026 3:12:40pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cstddef>
+#include "AlignedLanes.h"
+#include "Interpolation.h"
+
+namespace nvs::gran {
+
+/**
+ A source as interleaved frames: channel c of frame i is frames[i * numChannels + c], for i in
+ [-interp::guardFrames, length + interp::guardFrames).
+ */
+struct SourceView {
+	float const *frames {nullptr};
+	std::size_t length {0};	// in frames
+	int numChannels {0};
+};
+
+/**
+ The source the grains read, copied into interleaved frames (LRLR...), so that one interpolation neighbourhood brings in
+ both channels of a frame from the same cache lines rather than from two planar buffers.
+ A source with more than maxChannels channels is folded down: channel c is mixed into c % maxChannels.
+ 
+ The frames are cache-line aligned, and padded at either end with interp::guardFrames frames mirroring the other end, so that
+ the interpolators read across the wrap point without wrapping each tap (see Interpolation.h).
+ */
+class SourceBuffer {
+public:
+	static constexpr int maxChannels {2};	// the synth renders stereo
+
+	SourceBuffer() = default;
+	SourceBuffer(int numChannels, std::size_t length);	// silent
+	explicit SourceBuffer(juce::AudioBuffer<float> const &planar);
+	explicit SourceBuffer(SourceView const &source);	// a copy
+
+	std::size_t getLength() const { return _length; }
+	int getNumChannels() const { return _num_channels; }
+	float *getFrames() { return _storage.data() + guardSamples(); }
+	void fillGuards();	// after writing through getFrames()
+	SourceView view() const { return {_storage.data() + guardSamples(), _length, _num_channels}; }
+private:
+	AlignedLanes<float> _storage {0};	// guard, frames, guard
+	std::size_t _length {0};
+	int _num_channels {0};
+	
+	std::size_t guardSamples() const { return interp::guardFrames * static_cast<std::size_t>(_num_channels); }
+};
+}	// namespace nvs::gran
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    SourcePyramid.cpp
+    Created: 17 Oct 2026 12:36:02am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "SourcePyramid.h"
+#include "Interpolation.h"
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace nvs::gran {
+
+namespace {
+using DecimationFilter = std::array<float, SourcePyramid::filterTaps>;
+
+DecimationFilter makeDecimationFilter(){
+	constexpr int half {SourcePyramid::filterTaps / 2};
+	constexpr double beta {8.0};
+	std::array<double, SourcePyramid::filterTaps> h;
+	double sum {0.0};
+	for (int k = 0; k < SourcePyramid::filterTaps; ++k){
+		double const x = static_cast<double>(k - half);
+		double const arg = 2.0 * SourcePyramid::filterCutoff * x;
+		double const sinc = (k == half) ? 1.0 : std::sin(std::numbers::pi * arg) / (std::numbers::pi * arg);
+		h[static_cast<std::size_t>(k)] = sinc * interp::kaiserWindow(x / (half + 1), beta);
+		sum += h[static_cast<std::size_t>(k)];
+	}
+	DecimationFilter filter;
+	for (std::size_t k = 0; k < filter.size(); ++k){
+		filter[k] = static_cast<float>(h[k] / sum);	// unity gain at DC
+	}
+	return filter;
+}
+
+// one octave down: low-pass, keep every other frame; reads wrap around, as the grains' do
+bool decimate(SourceView const &in, SourceBuffer &out, DecimationFilter const &filter, std::function<bool()> const &shouldStop){
+	constexpr int half {SourcePyramid::filterTaps / 2};
+	constexpr int checkInterval {1 << 14};
+	auto const inLength = static_cast<long long>(in.length);
+	auto const channels = static_cast<std::size_t>(in.numChannels);
+	float *const frames = out.getFrames();
+	for (std::size_t j = 0; j < out.getLength(); ++j){
+		if (((j % checkInterval) == 0) && shouldStop()){
+			return false;
+		}
+		auto const first = 2 * static_cast<long long>(j) - half;
+		std::array<float, SourceBuffer::maxChannels> sum {};
+		if ((first >= 0) && (first + SourcePyramid::filterTaps <= inLength)){
+			float const *const x = in.frames + static_cast<std::size_t>(first) * channels;
+			for (std::size_t k = 0; k < filter.size(); ++k){
+				for (std::size_t c = 0; c < channels; ++c){
+					sum[c] += filter[k] * x[k * channels + c];
+				}
+			}
+		} else {
+			for (std::size_t k = 0; k < filter.size(); ++k){
+				auto i = (first + static_cast<long long>(k)) % inLength;
+				i += (i < 0) ? inLength : 0;
+				for (std::size_t c = 0; c < channels; ++c){
+					sum[c] += filter[k] * in.frames[static_cast<std::size_t>(i) * channels + c];
+				}
+			}
+		}
+		std::copy_n(sum.begin(), channels, frames + j * channels);
+	}
+	return true;
+}
+}	// end anonymous namespace
+
+std::unique_ptr<SourcePyramid> SourcePyramid::build(SourceView const &source, std::function<bool()> const &shouldStop){
+	static DecimationFilter const filter = makeDecimationFilter();
+	auto pyramid = std::make_unique<SourcePyramid>();
+	SourceView in = source;
+	for (int level = 1; level < maxLevels; ++level){
+		std::size_t const outLength = (in.length + 1) / 2;
+		if (outLength < minLength){
+			break;
+		}
+		auto &octave = pyramid->_octaves.emplace_back(in.numChannels, outLength);
+		if (!decimate(in, octave, filter, shouldStop)){
+			return nullptr;
+		}
+		octave.fillGuards();
+		in = octave.view();
+	}
+	return pyramid;
+}
+SourceView SourcePyramid::getOctave(int const octave) const {
+	assert ((octave >= 1) && (octave <= getNumOctaves()));
+	return _octaves[static_cast<std::size_t>(octave - 1)].view();
+}
+
+//=====================================================================================
+SourcePyramidBuilder::SourcePyramidBuilder(std::function<void(std::unique_ptr<SourcePyramid>)> onBuilt)
+:	juce::Thread("source pyramid builder")
+,	_on_built(std::move(onBuilt))
+{}
+SourcePyramidBuilder::~SourcePyramidBuilder(){
+	cancel();
+}
+void SourcePyramidBuilder::build(SourceView const &source){
+	cancel();
+	if ((source.numChannels == 0) || (source.length == 0)){
+		return;
+	}
+	_source = SourceBuffer(source);
+	startThread(juce::Thread::Priority::background);
+}
+void SourcePyramidBuilder::cancel(){
+	stopThread(-1);
+}
+void SourcePyramidBuilder::run(){
+	auto pyramid = SourcePyramid::build(_source.view(), [this]{ return threadShouldExit(); });
+	_source = {};	// the copy is only needed while building
+	if (pyramid && !threadShouldExit()){
+		_on_built(std::move(pyramid));
+	}
+}
+}	// namespace nvs::gran
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    SourcePyramid.h
+    Created: 17 Oct 2026 12:36:02am
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "SourceBuffer.h"
+
+namespace nvs::gran {
+
+/**
+ Octave-decimated copies of a source: octave l (from 1) is the source low-passed and decimated by 2^l, so a grain that steps
+ through the source 2^l samples or more per output sample can read octave l at under 2 instead, without aliasing the top
+ octaves down and with a fraction of the cache footprint. Level 0, the source itself, is not copied (see SourceLevels).
+ */
+class SourcePyramid {
+public:
+	static constexpr int maxLevels {8};			// the source and 7 octaves: 1/128 of its length
+	static constexpr int minLength {64};		// no octave shorter than this is built
+	static constexpr int filterTaps {47};		// the decimation low-pass: a Kaiser-windowed sinc
+	static constexpr double filterCutoff {0.225};	// cycles per input sample; the decimated Nyquist is 0.25
+
+	/**
+	 Builds the octaves of every channel of source, which wraps around like the grains' reads. Slow; run it off the audio
+	 thread. Returns nullptr if shouldStop() turns true along the way.
+	 */
+	static std::unique_ptr<SourcePyramid> build(SourceView const &source, std::function<bool()> const &shouldStop);
+
+	int getNumOctaves() const { return static_cast<int>(_octaves.size()); }
+	SourceView getOctave(int octave) const;	// octave in [1, getNumOctaves()]
+private:
+	std::vector<SourceBuffer> _octaves;
+};
+
+/**
+ One level of a SourceLevels, as a grain latches it when it starts: the grain reads these frames until it ends, or until
+ GrainPool::retarget() moves it onto a replacement source.
+ Reads wrap at period, the source's length in this level's samples, rather than at the level's own length: an octave of an
+ odd length is half a frame longer than half of it, so wrapping there would drift against level 0 at every pass.
+ */
+struct LevelView {
+	SourceView source;
+	double period {0.0};	// in (source.length - 1, source.length]
+	int level {0};
+};
+inline double wrapToPeriod(double const index, double const period){	// into [0, period)
+	if ((index >= 0.0) && (index < period)){
+		return index;
+	}
+	double const wrapped = index - period * std::floor(index / period);
+	return (wrapped < period) ? wrapped : 0.0;	// rounding can land a hair below 0 on exactly period
+}
+
+/**
+ What the renderers read: the loaded source, and its octaves once they are built.
+ Level 0 is always available; a level that is not (yet) is read from the highest one that is.
+ */
+struct SourceLevels {
+	SourceView base;
+	SourcePyramid const *octaves {nullptr};	// built from base, so with as many channels
+
+	int getNumLevels() const {
+		return 1 + ((octaves != nullptr) ? octaves->getNumOctaves() : 0);
+	}
+	SourceView getLevel(int level) const {
+		level = std::min(level, getNumLevels() - 1);
+		return (level <= 0) ? base : octaves->getOctave(level);
+	}
+	int levelFor(double const stride) const {	// the level at which stride source samples per output sample become [1, 2)
+		int const level = (stride >= 2.0) ? static_cast<int>(std::floor(std::log2(stride))) : 0;
+		return std::min(level, getNumLevels() - 1);
+	}
+	double periodOf(int const level) const {
+		return std::ldexp(static_cast<double>(base.length), -level);
+	}
+	LevelView latch(int level) const {
+		level = std::clamp(level, 0, getNumLevels() - 1);
+		return {getLevel(level), periodOf(level), level};
+	}
+};
+
+/**
+ Builds a SourcePyramid on its own thread and hands it to onBuilt, on that thread, when done.
+ build() copies the source first, so the caller's buffer may be replaced while the octaves are being built.
+ */
+class SourcePyramidBuilder	:	private juce::Thread
+{
+public:
+	explicit SourcePyramidBuilder(std::function<void(std::unique_ptr<SourcePyramid>)> onBuilt);
+	~SourcePyramidBuilder() override;
+
+	void build(SourceView const &source);	// cancels any build in progress
+	void cancel();	// waits for the build thread to stop; onBuilt is not called for the cancelled build
+private:
+	std::function<void(std::unique_ptr<SourcePyramid>)> _on_built;
+	SourceBuffer _source;
+
+	void run() override;
+};
+}	// namespace nvs::gran
@@ -10,6 +10,7 @@
 
 #pragma once
 
+// defaults only: the counts actually used are read from the "Settings" state in prepareToPlay (see GranularSynthesizer::setVoiceAndGrainCounts)
 static constexpr size_t N_GRAINS =
 #if defined(DEBUG_BUILD) | defined(DEBUG) | defined(_DEBUG)
 								12;
@@ -23,3 +24,6 @@ constexpr static int N_VOICES =
 #else
 										8;
 #endif
+
+static constexpr size_t MAX_GRAINS = 64;
+constexpr static int MAX_VOICES = 32;
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    Waveshaper.cpp
+    Created: 16 Oct 2026 10:18:45pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#include "Waveshaper.h"
+#include <JuceHeader.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define NVS_SHAPER_X86 1
+	#include <immintrin.h>
+	#if defined(__GNUC__) || defined(__clang__)
+		#define NVS_TARGET_AVX __attribute__((target("avx")))
+	#else
+		#define NVS_TARGET_AVX
+	#endif
+#else
+	#define NVS_SHAPER_X86 0
+#endif
+
+namespace nvs::gran::shaper {
+
+namespace {
+#if NVS_SHAPER_X86
+NVS_TARGET_AVX inline __m256 shapeAVX(__m256 const x, __m256 const drive, __m256 const gain){
+	__m256 const one = _mm256_set1_ps(1.f);
+	__m256 const absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+	__m256 const xd = _mm256_mul_ps(x, drive);
+	__m256 const denom = _mm256_add_ps(one, _mm256_sqrt_ps(_mm256_add_ps(one, _mm256_and_ps(xd, absMask))));
+	return _mm256_mul_ps(_mm256_div_ps(_mm256_add_ps(xd, xd), denom), gain);
+}
+NVS_TARGET_AVX
+void processAVX(float *const x, std::size_t const count, float const drive, float const gain){
+	__m256 const d = _mm256_set1_ps(drive);
+	__m256 const g = _mm256_set1_ps(gain);
+	std::size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(x + i, shapeAVX(_mm256_loadu_ps(x + i), d, g));
+	}
+	if (i < count){
+		processPortable(x + i, count - i, drive, gain);
+	}
+}
+NVS_TARGET_AVX
+void processRowsAVX(float *const x, std::size_t const numRows, float const *const drive, float const *const gain){
+	static_assert(rowWidth == 8);
+	__m256 const d = _mm256_loadu_ps(drive);
+	__m256 const g = _mm256_loadu_ps(gain);
+	for (std::size_t r = 0; r < numRows; ++r){
+		float *const row = x + r * rowWidth;
+		_mm256_storeu_ps(row, shapeAVX(_mm256_loadu_ps(row), d, g));
+	}
+}
+#endif
+
+using ProcessFn = void (*)(float *, std::size_t, float, float);
+using ProcessRowsFn = void (*)(float *, std::size_t, float const *, float const *);
+ProcessFn resolveProcess(){
+#if NVS_SHAPER_X86
+	if (juce::SystemStats::hasAVX()){
+		return processAVX;
+	}
+#endif
+	return processPortable;
+}
+ProcessRowsFn resolveProcessRows(){
+#if NVS_SHAPER_X86
+	if (juce::SystemStats::hasAVX()){
+		return processRowsAVX;
+	}
+#endif
+	return processRowsPortable;
+}
+ProcessFn const dispatchedProcess = resolveProcess();
+ProcessRowsFn const dispatchedProcessRows = resolveProcessRows();
+}	// end anonymous namespace
+
+void processPortable(float *const x, std::size_t const count, float const drive, float const gain){
+	for (std::size_t i = 0; i < count; ++i){
+		x[i] = shape(x[i], drive, gain);
+	}
+}
+void processRowsPortable(float *const x, std::size_t const numRows, float const *const drive, float const *const gain){
+	for (std::size_t r = 0; r < numRows; ++r){
+		for (std::size_t k = 0; k < rowWidth; ++k){
+			x[r * rowWidth + k] = shape(x[r * rowWidth + k], drive[k], gain[k]);
+		}
+	}
+}
+void process(float *const x, std::size_t const count, float const drive, float const gain){
+	dispatchedProcess(x, count, drive, gain);
+}
+void processRows(float *const x, std::size_t const numRows, float const *const drive, float const *const gain){
+	dispatchedProcessRows(x, numRows, drive, gain);
+}
+}	// namespace nvs::gran::shaper
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    Waveshaper.h
+    Created: 16 Oct 2026 10:18:45pm
+    Author:  Nicholas Solem
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <cstddef>
+#include <cmath>
+
+namespace nvs::gran::shaper {
+/**
+ The grainwise soft clipper, y = 2xd / (1 + sqrt(1 + |xd|)) * gain, over whole blocks.
+ gain already includes the drive normalization (see outputGain()), so it is resolved once per grain rather than per sample.
+ Unity drive is shaped like any other: the curve is continuous in drive, so a drive ramp through 1 does not step.
+
+ As with interp::hermiteGather, the implementation is chosen once at runtime: AVX where the CPU has it, otherwise a portable loop.
+ */
+inline float normalization(float const drive){	// the shaped value of x = 1, so that a full-scale input stays full scale
+	return (2.f * drive) / (1.f + std::sqrt(1.f + std::abs(drive)));
+}
+inline float outputGain(float const drive, float const makeupGain){
+	return makeupGain / normalization(drive);
+}
+inline float shape(float const x, float const drive, float const gain){
+	float const xd = x * drive;
+	return (2.f * xd) / (1.f + std::sqrt(1.f + std::abs(xd))) * gain;
+}
+
+inline constexpr std::size_t rowWidth {8};	// GrainBank's laneWidth
+
+void process(float *x, std::size_t count, float drive, float gain);	// in place, one drive and gain for the whole block
+void processRows(float *x, std::size_t numRows, float const *drive, float const *gain);	// in place; x is numRows rows of rowWidth lanes, drive and gain are per lane
+
+// always available; useful to compare against the dispatched kernels
+void processPortable(float *x, std::size_t count, float drive, float gain);
+void processRowsPortable(float *x, std::size_t numRows, float const *drive, float const *gain);
+}	// namespace nvs::gran::shaper
@@ -12,6 +12,8 @@
 #include "sprout/math.hpp"
 //#include "sprout/math/constants.hpp"
 #include <span>
+#include <bit>
+#include <cstdint>
 
 namespace nvs {
 namespace util {
@@ -34,6 +36,15 @@ template<size_t N>
 inline bool checkNanOrInf(std::array<float, N> sp) {
 	return checkNanOrInf(std::span<float>(sp));
 }
+// one branch-free pass over a block: NaN and Inf are exactly the floats whose exponent bits are all set.
+// integer ops only, so it vectorizes without fast-math (and fast-math cannot fold it away the way it can std::isnan).
+inline bool anyNonFinite(float const *x, std::size_t n) {
+	std::uint32_t found {0};
+	for (std::size_t i = 0; i < n; ++i){
+		found |= static_cast<std::uint32_t>((std::bit_cast<std::uint32_t>(x[i]) & 0x7f800000u) == 0x7f800000u);
+	}
+	return found != 0;
+}
 
 
 inline float scale(float val, float min, float range){
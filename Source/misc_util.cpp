@@ -22,18 +22,6 @@ LoggingGuts::~LoggingGuts()
 	fileLogger.trimFileSize(logFile , 64 * 1024);
 	juce::Logger::setCurrentLogger (nullptr);
 }
-void LoggingGuts::logIfNaNOrInf(juce::AudioBuffer<float> buffer){
-	float rms = 0.f;
-	for (auto ch = 0; ch < buffer.getNumChannels(); ++ch){
-		rms += buffer.getRMSLevel(ch, 0, buffer.getNumSamples());
-	}
-	if (rms != rms) {
-		fileLogger.writeToLog("processBlock:						rms was NaN");
-	}
-	if (std::isinf(rms)) {
-		fileLogger.writeToLog("processBlock:						rms was Inf");
-	}
-}
 
 SampleManagementGuts::SampleManagementGuts()
 {
@@ -64,21 +52,32 @@ bool SampleManagementGuts::loadAudioFile(const juce::File& file)
 	sampleRate = reader->sampleRate;
 
 
-	const auto normGain = [&reader](){
-		std::array<juce::Range<float> , 1> normalizationRange;
-		reader->readMaxLevels(0, reader->lengthInSamples, &normalizationRange[0], 1);
-		const auto min = normalizationRange[0].getStart();
-		const auto max = normalizationRange[0].getEnd();
-
-		if (auto const normVal = std::max(std::abs(min), std::abs(max)); normVal > 0.f){
-			return 1.f / normVal;
-		}
+	std::vector<juce::Range<float>> normalizationRanges (std::max(reader->numChannels, 1u));
+	reader->readMaxLevels(0, reader->lengthInSamples, normalizationRanges.data(), static_cast<int>(normalizationRanges.size()));
+	const auto peakOf = [](juce::Range<float> const &range){
+		return std::max(std::abs(range.getStart()), std::abs(range.getEnd()));
+	};
+	const auto gainFor = [](float const peak){
+		return (peak > 0.f) ? 1.f / peak : 1.f;
+	};
+	
+	// normalized on the loudest channel, so that the channels keep their balance
+	float peak {0.f};
+	for (auto const &range : normalizationRanges){
+		peak = std::max(peak, peakOf(range));
+	}
+	if (peak == 0.f){
 		std::cerr << "either the sample is digital silence, or something's gone wrong\n";
-		return 1.f;
-	}();
+	}
+	
+	// The key stored in FileInfo and by the analyzer is channel 0 normalized on its own peak, as every file was before the
+	// normalization above took the other channels into account; hashing anything else would orphan the stored analyses.
+	juce::AudioBuffer<float> keyChannel (1, lengthInSamps);
+	keyChannel.copyFrom(0, 0, sampleBuffer, 0, 0, lengthInSamps);
+	keyChannel.applyGain(gainFor(peakOf(normalizationRanges[0])));
+	audioHash = computeHash(keyChannel);
 	
-	sampleBuffer.applyGain(normGain);
-	audioHash = computeHash(sampleBuffer);
+	sampleBuffer.applyGain(gainFor(peak));
 	return true;
 }
 
@@ -88,7 +87,7 @@ juce::String computeHash(const juce::AudioBuffer<float> &bufferToHash)
 		return {};
 	}
 	
-	// Hash just based on channel 0 (consistent with analyzer)
+	// Hash just based on channel 0 (consistent with analyzer), so that keys stored before stereo sources were granulated still match
 	std::vector<float> audioData;
 	audioData.reserve(bufferToHash.getNumSamples());
 	
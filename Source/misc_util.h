@@ -43,7 +43,6 @@ struct LoggingGuts {
 	~LoggingGuts();
 	File logFile;
 	FileLogger fileLogger;
-	void logIfNaNOrInf(juce::AudioBuffer<float> buffer);
 };
 
 juce::String computeHash(const juce::AudioBuffer<float> &bufferToHash);